@@ -16,6 +16,15 @@
 #include <cstdint>
 #include <cmath>
 
+// Why a car stopped being simulated before it finished its run
+enum class RetireReason {
+    NONE,
+    CACHED,  // Fitness on this course already known
+    MERGED,  // Stands in an identical leader
+    HALVED,  // Not promoted past a successive-halving rung
+    PRUNED   // Provably unable to reach the cars that will be selected
+};
+
 class Car {
 public:
 
@@ -29,13 +38,34 @@ public:
     Car(float x, float y, float w, float h, ControlType type = ControlType::AI, float maxSpd = 3.0f, sf::Color col = sf::Color::Blue);
 
     void update(const Road& road, const std::vector<Obstacle*>& obstacles, sf::Time deltaTime);
-    void draw(sf::RenderTarget& target, bool drawSensorFlag = false);
+    void appendSensorVertices(std::vector<sf::Vertex>& lines) const;
+    sf::Color getDrawColor() const; // Body colour, darkened and translucent once damaged
+    // Shared by every car and loaded on first draw, so headless cars never need a GL context
+    static const sf::Texture* getSharedTexture();
     std::vector<sf::Vector2f> getPolygon() const;
     bool isDamaged() const { return damaged; }
     float getFitness() const { return currentFitness; }
     float getSpeed() const { return speed; }
     int getSensorRayCount() const;
+    float getSensorRayLength() const;
     void resetForNewGeneration(float startY, const Road& road);
+    // Stops simulating this car with a fitness known from elsewhere (cache, identical car)
+    void retire(float finalFitness, RetireReason reason);
+    bool isRetired() const { return retireReason != RetireReason::NONE; }
+    RetireReason getRetireReason() const { return retireReason; }
+    // Identical agents (same genome, same state) are merged into one simulated leader. Merged
+    // cars hold no state of their own, so with deterministic steps they cannot diverge; they are
+    // split back out at the end of the run.
+    void mergeInto(Car& leader);
+    void splitFrom(const Car& leader); // Takes over the leader's state and outcome
+    int getMultiplicity() const { return multiplicity; }
+    uint64_t getStateHash() const; // Kinematic state that, with the genome, determines the trajectory
+    bool sameState(const Car& other) const; // Exact comparison of the state getStateHash covers
+    // Bounds on the fitness this car can end with after 'remainingSeconds' more simulated time in
+    // steps of 'timeStep', from maxSpeed and the fitness constants. Exact once the car is damaged.
+    float getMaxTravel(float remainingSeconds, float timeStep) const;
+    float getFitnessUpperBound(float remainingSeconds, float timeStep, float laneWidth, int maxOvertakes) const;
+    float getFitnessLowerBound(float remainingSeconds, float timeStep) const;
 
 private:
     // Physics and Control
@@ -45,13 +75,12 @@ private:
      float maxSpeed;
      float friction = 0.05f;
      bool damaged = false;
+     RetireReason retireReason = RetireReason::NONE;
+     int multiplicity = 1; // Agents this car stands for, itself included
      ControlType controlType;
      Controls controls;
      std::unique_ptr<Sensor> sensor;
      sf::Color color;
-     sf::Texture texture;
-     sf::Sprite sprite;
-     bool textureLoaded;
 
     void updateBasedOnControls(Controls controls);
 
@@ -73,7 +102,6 @@ private:
     std::unordered_set<long long> passedObstacleIDs;
 
     // Auxiliary methods
-    void loadTexture(const std::string& filename);
     void move(float aiBrakeSignal, sf::Time deltaTime);
     void checkStoppedStatus(sf::Time deltaTime);
     void checkReversingStatus(sf::Time deltaTime);
@@ -84,10 +112,12 @@ private:
                              Obstacle*& hitObstacle);
     float calculateDesiredAcceleration(std::vector<float> outputs);
     int getCurrentLaneIndex(const Road& road) const;
+    int getSettledLaneIndex(const Road& road) const; // -1 within LANE_CHANGE_HYSTERESIS of a lane edge
 
     // CONSTANTS TO DO MOVE TO MAIN HEADER CLASS
     static constexpr float FITNESS_SPINNING_PENALTY = 1.0f;
     static constexpr float FITNESS_LANE_CHANGE_BONUS = 25.0f;
+    static constexpr float LANE_CHANGE_HYSTERESIS = 0.25f; // Fraction of a lane width on each side of a lane line
     static constexpr float FITNESS_SPEED_REWARD_THRESHOLD = 1.5f;
     static constexpr float FITNESS_FRAME_SURVIVAL_REWARD = 0.05f;
     static constexpr float FITNESS_SPEED_REWARD = 0.1f;
@@ -0,0 +1,97 @@
+#ifndef DISTRIBUTED_TRAINING_HPP
+#define DISTRIBUTED_TRAINING_HPP
+
+#include "ObstacleGenerator.hpp"
+#include "Network.hpp"
+#include "HistoryStore.hpp"
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+struct DistributedSettings {
+    std::string executablePath;                     // Re-executed with --worker for each local worker
+    std::string socketPath;                         // Empty = a fresh private directory under $TMPDIR or /tmp
+    int workerCount = 2;
+    int generations = 50;
+    int populationSize = 256;
+    int genomesPerBatch = 8;                        // Genomes per message; small batches balance better
+    float maxSecondsPerRun = 60.0f;
+    // Same road and courses the window uses at its reference 1200 px width
+    float roadCenterX = 100.0f;
+    float roadWidth = 180.0f;
+    int laneCount = 3;
+    CourseLayout course = {{20.0f, 40.0f, 40.0f, 80.0f, 75.0f, 150.0f}, 1000.0f, -100.0f, 12};
+    int scenarioCount = 16;
+    int scenarioChunkCount = 12;
+    int scenarioSubsetSize = 4;
+    uint64_t scenarioSeed = 20240601;
+    // Mutation schedule, as in the windowed trainer
+    float initialMutationRate = 0.15f;
+    float minMutationRate = 0.005f;
+    float mutationDecayFactor = 0.025f;
+    std::string brainFilename = "bestBrain.dat";   // Loaded at start, saved at the end; empty = neither
+};
+
+// Coordinator of a multi-process training run. Owns the GA state (elite brain, mutation
+// rate, history), spawns local worker processes and hands them genome batches over a
+// Unix-domain socket; workers return one fitness per genome.
+class TrainingCoordinator {
+public:
+    TrainingCoordinator(const DistributedSettings& settings, const std::vector<int>& networkStructure);
+    TrainingCoordinator(const DistributedSettings& settings, const NeuralNetwork& initialBrain);
+    ~TrainingCoordinator();
+
+    TrainingCoordinator(const TrainingCoordinator&) = delete;
+    TrainingCoordinator& operator=(const TrainingCoordinator&) = delete;
+
+    // Trains for settings.generations generations; false if the workers could not be started
+    bool run();
+
+    double getEvaluationsPerSecond() const; // Over the whole run, excluding start-up
+    double getTicksPerSecond() const;       // Simulation steps per second; fair across runs whose cars crash at different times
+    const HistoryStore& getBestFitnessHistory() const { return bestFitnessHistory; }
+
+    // Runs a short training with 1, 2, 4 ... maxWorkers workers from the same initial brain
+    // and prints the throughput of each
+    static void runScalingReport(DistributedSettings settings, const std::vector<int>& networkStructure, int maxWorkers);
+
+private:
+    struct WorkerConnection {
+        int pid = -1;
+        int socket = -1;
+        bool busy = false;
+        uint32_t batchId = 0;
+        size_t first = 0; // Population slice of the batch in flight
+        size_t count = 0;
+    };
+
+    DistributedSettings settings;
+    std::vector<int> networkStructure;
+    std::unique_ptr<NeuralNetwork> bestBrainOfGeneration;
+    float currentMutationRate;
+    HistoryStore averageFitnessHistory;
+    HistoryStore bestFitnessHistory;
+    std::vector<WorkerConnection> workers;
+    int listenSocket = -1;
+    std::string activeSocketPath;  // Bound by us, so ours to unlink
+    std::string socketDirectory;   // Created by us when settings.socketPath is empty
+
+    long long evaluationsDone = 0;
+    long long ticksSimulated = 0;
+    double evaluationSeconds = 0.0;
+
+    bool startWorkers();
+    bool listenOnSocket();
+    void closeListenSocket();
+    void stopWorkers();
+    bool evaluateGeneration(const std::vector<NeuralNetwork>& population, uint32_t scenarioId, std::vector<float>& fitness);
+    bool sendBatch(WorkerConnection& worker, const std::vector<NeuralNetwork>& population,
+                   size_t first, size_t count, uint32_t scenarioId);
+
+};
+
+// Entry point of a worker process (--worker <socket>): evaluates batches until told to stop
+int runTrainingWorker(const std::string& socketPath);
+
+#endif // DISTRIBUTED_TRAINING_HPP
@@ -0,0 +1,74 @@
+#ifndef EVOLUTION_STRATEGY_HPP
+#define EVOLUTION_STRATEGY_HPP
+
+#include "Network.hpp"
+#include "HeadlessWorld.hpp"
+#include "WorkerPool.hpp"
+#include <vector>
+#include <memory>
+#include <optional>
+#include <limits>
+#include <cstdint>
+
+class Road;
+struct DistributedSettings;
+
+struct EsSettings {
+    int pairsPerIteration = 32;   // Antithetic pairs: 2x this many evaluations per iteration
+    float noiseStdDev = 0.1f;
+    float learningRate = 0.1f;
+    float weightDecay = 0.005f;
+    float maxSecondsPerRun = 60.0f;
+    int scenarioSubsetSize = 4;   // One scenario per iteration, rotating through the first N
+    size_t workerCount = 0;       // 0 = one per hardware thread
+    uint64_t noiseSeed = 1;
+};
+
+// OpenAI-style evolution strategy over the flattened genome of a NeuralNetwork.
+// Each iteration scores mean +/- sigma * noise for a set of antithetic pairs and moves the
+// mean along the rank-weighted noise. Noise comes from a counter-based generator, so any
+// worker rebuilds candidate k from (seed, iteration, k) and the mean alone.
+class EvolutionStrategy {
+public:
+    // 'bank' must outlive the optimiser
+    EvolutionStrategy(const Road& road, const CourseLayout& course, const ScenarioBank& bank,
+                      const NeuralNetwork& initialMean, const EsSettings& settings);
+
+    // Runs one iteration; returns the best candidate fitness on this iteration's scenario
+    float step();
+
+    int getIteration() const { return iteration; }
+    long long getEvaluations() const { return evaluations; }
+    long long getTicksSimulated() const;
+    // Best mean over the first scenarioSubsetSize scenarios, the same common set IslandModel
+    // scores its champions on. Each iteration's best candidate is re-scored on it.
+    float getBestFitness() const { return bestFitness; }
+    const NeuralNetwork& getBestGenome() const { return *bestGenome; }
+    NeuralNetwork getMean() const;
+
+    // Standard normal value determined only by its arguments
+    static float noise(uint64_t seed, uint64_t iteration, uint64_t candidate, uint64_t parameter);
+
+    // Headless ES training from settings.brainFilename (or a random brain); saves the best
+    // candidate back to it at the end
+    static bool runTraining(const DistributedSettings& settings, const std::vector<int>& networkStructure, int iterations);
+
+    // Trains the GA (once per selection scheme, same evaluation budget per generation) and the ES
+    // from the same initial brain and prints the time each needs to reach 'targetFitness' on the common set
+    static void runComparison(const DistributedSettings& settings, const std::vector<int>& networkStructure,
+                              float targetFitness, float timeLimitSeconds);
+
+private:
+    const ScenarioBank& bank;
+    EsSettings settings;
+    WorkerPool pool;
+    std::vector<std::unique_ptr<HeadlessWorld>> worlds; // Indexed by pool worker
+    std::vector<NeuralNetwork> workerNetworks;           // Scratch candidate per pool worker
+    std::vector<float> mean;
+    int iteration = 0;
+    long long evaluations = 0;
+    float bestFitness = -std::numeric_limits<float>::infinity();
+    std::optional<NeuralNetwork> bestGenome;
+};
+
+#endif // EVOLUTION_STRATEGY_HPP
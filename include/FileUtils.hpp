@@ -0,0 +1,10 @@
+#ifndef FILE_UTILS_HPP
+#define FILE_UTILS_HPP
+
+#include <string>
+
+// Writes to a temporary file, flushes it to disk, renames it over 'filename' and syncs
+// the directory, so readers (even after a crash) see either the old file or the complete new one
+bool writeFileAtomic(const std::string& filename, const std::string& contents);
+
+#endif // FILE_UTILS_HPP
@@ -0,0 +1,46 @@
+#ifndef FITNESS_CACHE_HPP
+#define FITNESS_CACHE_HPP
+
+#include <unordered_map>
+#include <deque>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+// Fitness of genomes already driven on a course, keyed by (genome hash, course seed).
+// Only valid while scoring is deterministic: fixed time step, same time limit.
+// Oldest entries are evicted first once the capacity is reached.
+class FitnessCache {
+public:
+    explicit FitnessCache(size_t capacity = 8192);
+
+    std::optional<float> find(uint64_t genomeHash, uint64_t courseSeed);
+    void insert(uint64_t genomeHash, uint64_t courseSeed, float fitness);
+    void clear();
+
+    size_t size() const { return entries.size(); }
+    long long getHits() const { return hits; }
+    long long getMisses() const { return misses; }
+
+private:
+    struct Key {
+        uint64_t genomeHash;
+        uint64_t courseSeed;
+        bool operator==(const Key& other) const {
+            return genomeHash == other.genomeHash && courseSeed == other.courseSeed;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return static_cast<size_t>(key.genomeHash ^ (key.courseSeed * 0x9E3779B97F4A7C15ull));
+        }
+    };
+
+    size_t capacity;
+    std::unordered_map<Key, float, KeyHash> entries;
+    std::deque<Key> insertionOrder;
+    long long hits = 0;
+    long long misses = 0;
+};
+
+#endif // FITNESS_CACHE_HPP
@@ -0,0 +1,88 @@
+#ifndef FRAME_CAPTURE_HPP
+#define FRAME_CAPTURE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <deque>
+#include <string>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+// Records the window to disk while the simulation runs, without the main loop waiting for the disk.
+// Frames are copied into a fixed pool of buffers allocated by start(); a worker thread converts
+// and writes them. When every buffer is still queued for writing, the frame is dropped and counted
+// instead of stalling the caller. Drops only add to a repeat count on the frame before them: once the
+// writer has caught up, it writes that frame again in their place so the recording keeps its frame
+// rate, but repeats are skipped while captured frames are waiting, so dropping sheds disk load.
+// Y4M is one raw 4:2:0 stream (ffmpeg and most players read it); a PPM sequence writes one RGB file per frame.
+//
+// SFML 3 only reads a window back through sf::Texture::copyToImage, which allocates a new sf::Image
+// per frame on the window thread; the pool saves the conversion and the disk, not that allocation.
+class FrameCapture {
+public:
+    enum class Format { Y4M, PPM_SEQUENCE };
+
+    explicit FrameCapture(size_t poolSize = 4);
+    ~FrameCapture(); // stop()
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Records frames of 'windowSize' into a new timestamped file (or directory) under 'directory'
+    bool start(const std::filesystem::path& directory, Format format, sf::Vector2u windowSize, unsigned framesPerSecond);
+    void stop(); // Writes what is still queued, then closes the output
+    bool isActive() const { return active; }
+
+    // After drawing and before window.display(). Frames of another size than the one
+    // recording started with (the window was resized) are dropped like frames the worker is behind on.
+    void capture(const sf::RenderWindow& window);
+
+    const std::filesystem::path& getOutputPath() const { return outputPath; }
+    uint64_t getFramesCaptured() const { return framesCaptured; }
+    uint64_t getFramesDropped() const { return framesDropped; }
+    uint64_t getFramesWritten() const { return framesWritten.load(std::memory_order_relaxed); }
+    uint64_t getFramesRepeated() const { return framesRepeated.load(std::memory_order_relaxed); }
+
+private:
+    struct Frame {
+        std::vector<std::uint8_t> pixels; // RGBA, as read back
+    };
+    struct QueuedFrame {
+        Frame* frame = nullptr;
+        uint64_t repeats = 0; // Frames dropped right after this one
+    };
+
+    size_t poolSize;
+    std::vector<Frame> pool;
+    std::vector<Frame*> freeFrames;    // Guarded by queueMutex
+    std::deque<QueuedFrame> queuedFrames; // Guarded by queueMutex; written in order
+    uint64_t writingRepeats = 0;       // Guarded by queueMutex; drops after the frame the worker took last
+    bool stopping = false;             // Guarded by queueMutex
+    std::mutex queueMutex;
+    std::condition_variable workAvailable;
+    std::thread worker;
+
+    bool active = false;
+    Format format = Format::Y4M;
+    sf::Vector2u windowSize;
+    sf::Vector2u frameSize; // Window size rounded down to even, as 4:2:0 needs
+    sf::Texture readbackTexture;
+    std::filesystem::path outputPath;
+    std::ofstream stream; // Y4M only; used by the worker while active
+    uint64_t framesCaptured = 0;
+    uint64_t framesDropped = 0;
+    std::atomic<uint64_t> framesWritten{0};  // Repeats included
+    std::atomic<uint64_t> framesRepeated{0};
+
+    void dropFrame();
+    void workerLoop();
+    void convertFrame(const Frame& frame, std::vector<std::uint8_t>& converted) const;
+    bool writeConverted(const std::vector<std::uint8_t>& converted, uint64_t outputNumber);
+};
+
+#endif // FRAME_CAPTURE_HPP
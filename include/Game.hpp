@@ -7,14 +7,33 @@
 #include <string>
 #include <deque>
 #include "Road.hpp"
+#include "Car.hpp"
+#include "ObstacleStreamer.hpp"
+#include "ScenarioEvaluator.hpp"
+#include "IslandModel.hpp"
+#include "PersistenceWorker.hpp"
+#include "FitnessCache.hpp"
+#include "GenerationPreparer.hpp"
+#include "Selection.hpp"
+#include "PopulationRenderer.hpp"
+#include "Visualizer.hpp"
+#include "HistoryStore.hpp"
+#include "TripleBuffer.hpp"
+#include "WorldSnapshot.hpp"
+#include "FrameCapture.hpp"
+#include <optional>
 #include <iostream>
 #include <algorithm>
 #include <filesystem>
 #include <numeric>
 #include <cmath>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <future>
 
 // Forward declarations
-class Car;
 class Obstacle;
 class Road;
 class NeuralNetwork;
@@ -26,6 +45,20 @@ enum class GameState {
     HELP
 };
 
+// Why a generation ended; it can be reached before robust evaluation has finished
+enum class GenerationEnd {
+    NONE,
+    ALL_DAMAGED,
+    STALLED,
+    TIME_LIMIT
+};
+
+enum class CourseMode {
+    RANDOM,             // Fresh random course every generation
+    FIXED_SCENARIO,     // Always scenario 0 of the bank
+    ROTATING_SCENARIOS  // Cycle through a subset of the bank, one scenario per generation
+};
+
 class Game {
 public:
     Game();
@@ -68,12 +101,46 @@ private:
     const std::string VISUALIZE_BRAIN_FILENAME = "backups/bestBrain.dat"; // File to load for visualization
     bool loadSpecificBrainOnStart;
 
+    // --- Redraw Tracking ---
+    // The window thread sleeps in waitEvent whenever the next frame would look like the last one
+    bool redrawNeeded = true;               // Set by every event
+    bool simulationPausedOnScreen = false;  // From the last snapshot drawn
+    bool cameraSettled = false;             // carView reached the focused car
+
     // --- Simulation Object Members ---
     std::vector<std::unique_ptr<Car>> cars;
     std::vector<std::unique_ptr<Obstacle>> obstacles;
     std::vector<Obstacle*> obstacleRawPtrs; // Raw pointers for faster collision checks (non-owning)
+    std::unique_ptr<ObstacleStreamer> obstacleStreamer; // Background chunk generation
+    std::deque<ObstacleChunk> liveChunks; // Chunks whose obstacles are spawned, in index order
+    long long nextChunkToSpawn = 0;
+    uint64_t courseSeed = 0;
+    std::unique_ptr<ScenarioBank> scenarioBank;
+    CourseMode courseMode = CourseMode::ROTATING_SCENARIOS;
+    int currentScenarioId = -1; // -1 while driving a random course
+    // Robust evaluation (E key): while a generation drives on screen, scenarioEvaluator's workers
+    // score every genome of it on several bank scenarios, and selection uses those scores
+    std::unique_ptr<ScenarioEvaluator> scenarioEvaluator; // Created on first robust evaluation
+    bool robustEvaluationEnabled = false;
+    bool robustEvaluationActive = false; // Latched when a generation starts
+    std::vector<NeuralNetwork> robustGenomes; // Copies for the workers; the cars keep driving theirs
+    std::vector<int> robustGenomeOfCar;       // Per car: index into robustGenomes, or -1
+    std::future<std::vector<float>> robustEvaluation;
+    std::atomic<bool> robustEvaluationCancelled{false};
+    std::vector<float> robustCarFitness; // Per car, once the generation's robust scores are in
+    sf::Clock robustEvaluationClock; // Restarted with each evaluation, i.e. when its generation starts
+    long long robustTicksAtStart = 0;
+    float generationOnScreenMs = 0.0f; // Wall time from the generation's start until its cars stopped
+    GenerationEnd pendingGenerationEnd = GenerationEnd::NONE; // Reached while the robust scores were still running
+    std::unique_ptr<IslandModel> islandModel; // Background island GA; declared after the bank it reads
+    // Common-set score of the last elite the island model judged. Judging runs in the background, so a
+    // champion is compared at the first boundary at which the judged elite is still the elite.
+    std::optional<NeuralNetwork> islandJudgedElite;
+    float islandJudgedEliteFitness = 0.0f;
 
     std::unique_ptr<NeuralNetwork> bestBrainOfGeneration;
+    PersistenceWorker persistenceWorker; // Brain and checkpoint files are written off the simulation thread
+    long long lastSaveQueueMicroseconds = 0;
     std::vector<int> networkStructure; // e.g., {5, 6, 4}
 
     Car* bestCarVisual; // Pointer to the car visually furthest ahead (non-owning)
@@ -86,8 +153,101 @@ private:
     std::vector<Car*> navigableCars; // List of cars for manual navigation cycle
     int currentNavIndex;
 
+    // --- Status Panel ---
+    // Counts maintained by the simulation step, so the panel never scans the population itself
+    int aliveCarCount = 0;   // Simulated cars still running
+    int aliveAgentCount = 0; // The same, counting the agents merged into each
+    int prunedThisGeneration = 0;
+    bool statusPanelDirty = true; // Refresh on the next frame regardless of the rate cap
+    sf::Clock statusRefreshClock;
+    std::string statusString; // Simulation part of the panel, published through the snapshots
+    uint64_t statusVersion = 0; // Bumped whenever statusString changes
+    std::string displayedStatus; // Text last handed to statusText; setString re-lays out glyphs
+    uint64_t displayedStatusVersion = 0; // Snapshot status it was composed from
+    sf::Clock displayedStatusClock;
+    const float STATUS_REFRESH_INTERVAL_SECONDS = 0.1f;
+
+    // --- Simulation Thread ---
+    // In SIMULATION the steps run on their own thread while this one handles events and draws
+    // the newest snapshot, so a slow frame never delays the simulation or the other way round.
+    // The simulation thread owns every simulation member; the render thread only reads
+    // snapshots. Key presses cross over through the queue and are applied between steps.
+    TripleBuffer<WorldSnapshot> snapshots;
+    std::thread simulationThread;
+    std::atomic<bool> simulationThreadStopping{false};
+    std::mutex commandMutex;
+    std::condition_variable commandAvailable; // A paused simulation sleeps on it
+    // A paused simulation publishes only in reply to a key, so after forwarding one the window
+    // waits this long for the reply and then blocks in waitEvent
+    std::condition_variable pausedSnapshotPublished;
+    bool awaitingPausedSnapshot = false; // Window thread only
+    const float PAUSED_REPLY_TIMEOUT_SECONDS = 0.1f;
+    std::vector<sf::Event::KeyPressed> pendingKeyPresses; // Guarded by commandMutex
+    // The RNG is per thread, so a resumed checkpoint's RNG state is applied by the simulation
+    // thread when it starts, not by the window thread that loads it
+    std::string pendingRandomState;
+    // Rates shown in the status panel, each measured over about a second on its own thread
+    sf::Clock stepRateClock;
+    int stepsSinceRateUpdate = 0;
+    float stepsPerSecond = 0.0f;
+    sf::Clock frameRateClock;
+    int framesSinceRateUpdate = 0;
+    float worstFrameSecondsSinceRateUpdate = 0.0f;
+    float framesPerSecond = 0.0f;
+    float worstFrameMs = 0.0f;
+
+    // --- Recording (V key) ---
+    FrameCapture frameCapture; // Window thread only
+    const std::string CAPTURE_DIRECTORY = "captures";
+    const FrameCapture::Format CAPTURE_FORMAT = FrameCapture::Format::Y4M;
+    const unsigned CAPTURE_FRAMES_PER_SECOND = 60; // The window's frame rate limit
+
+    // --- Profiler (F3 overlay, F4 dump) ---
+    bool profilerOverlayVisible = false;
+    sf::Text profilerText;
+    sf::RectangleShape profilerBackground;
+    sf::Clock profilerOverlayClock; // The overlay's percentiles are recomputed at the status panel's rate
+    const std::string PROFILE_DIRECTORY = "profiles";
+
     sf::Clock clock;
     sf::Clock generationClock;
+    float generationSimulatedSeconds = 0.0f; // Drives the time limit and stall checks
+    float simulationTimeAccumulator = 0.0f;  // Frame time not yet consumed by fixed steps
+
+    // --- Fitness Cache (genome hash + course seed -> fitness) ---
+    FitnessCache fitnessCache;
+    std::vector<uint64_t> carGenomeHashes; // Per car, for the current generation
+    std::vector<int> duplicateLeaders;     // Per car: index of the identical agent it is merged into, or -1
+    std::optional<float> eliteCachedFitness; // Set when the elite was scored from the cache this generation
+
+    // --- Successive Halving (short budget for all, longer budgets for the best fraction) ---
+    bool successiveHalvingEnabled = false; // Training only; latched into halvingActive at generation start
+    bool halvingActive = false;
+    size_t halvingRung = 0;               // Next rung to be judged this generation
+    float nextPruneCheckSeconds = 0.0f;   // Simulated time of the next hopeless-car check
+    long long generationTicksSimulated = 0;
+    long long lastGenerationTicks = 0;
+
+    // --- Next Generation Preparation (offspring built on a worker, swapped in at the boundary) ---
+    GenerationPreparer generationPreparer;
+    std::vector<NeuralNetwork> preparedOffspring; // Storage swapped with the cars' brains
+    std::vector<uint64_t> preparedGenomeHashes;   // Per car, when the offspring came prepared
+    bool preparedOffspringUsed = false;
+    float lastBoundaryMs = 0.0f; // Wall time of the last generation end-to-start transition
+    float maxBoundaryMs = 0.0f;
+
+    // --- Selection (X key: elite clones or multi-parent tournament + crossover) ---
+    SelectionSettings selectionSettings = multiParentSelection(CrossoverMode::UNIFORM);
+    std::vector<NeuralNetwork> matingPool; // Best brains of the finished generation, elite first
+    std::vector<float> matingPoolFitness;
+    std::vector<NeuralNetwork> bredOffspring; // Storage swapped with the cars' brains
+    std::vector<NeuralNetwork> speculatedMatingPool; // Guess of matingPool handed to generationPreparer
+    std::vector<float> speculatedMatingPoolFitness;
+
+    PopulationRenderer populationRenderer; // Every car except the focused one, in one draw call
+    size_t obstaclesDrawn = 0; // Submitted by the last frame; the rest were outside carView
+    size_t obstaclesCulled = 0;
+    Visualizer networkVisualizer; // Keeps the network panel geometry between frames
 
     // --- Simulation Speed Control ---
     float simulationSpeedMultiplier = 1.0f;
@@ -97,23 +257,57 @@ private:
     const float SPEED_ADJUSTMENT_FACTOR = 1.2f;
 
     // --- Graphing Members ---
-    std::deque<float> averageFitnessHistory;
-    std::deque<float> bestFitnessHistory;
-    std::deque<float> mutationRateHistory;
+    // The whole run is kept, downsampled into a fixed number of buckets per series
+    HistoryStore averageFitnessHistory;
+    HistoryStore bestFitnessHistory;
+    HistoryStore mutationRateHistory;
+    std::vector<HistoryStore> islandBestHistory; // One per island, sampled at each generation end
+    HistoryStore islandGlobalBestHistory;
+    // Graph geometry is rebuilt only when the histories change or the panel is resized
+    uint64_t graphDataVersion = 0;
+    uint64_t graphBuiltVersion = 0;
+    sf::Vector2f graphBuiltSize;
+    sf::VertexArray graphLines{sf::PrimitiveType::Lines}; // Axes, min/max bands and every series
+    std::vector<sf::Text> graphLegends;
     float currentMutationRate;
-    const size_t MAX_HISTORY_POINTS = 200; // Max data points for graphs
     const float INITIAL_MUTATION_RATE = 0.15f;
     const float MIN_MUTATION_RATE = 0.005f;
     const float MUTATION_DECAY_FACTOR = 0.025f; // Controls how fast mutation decays
 
+    // --- Convergence Tracking (generations/time until best fitness reaches the target) ---
+    sf::Clock convergenceClock;
+    int convergenceStartGeneration = 1;
+    int targetReachedGeneration = -1;
+    float targetReachedSeconds = 0.0f;
+    float convergenceSecondsBeforeResume = 0.0f; // Training time restored from a checkpoint
+    const float TARGET_FITNESS = 5000.0f;
+
     // --- Simulation Constants ---
     const std::string DEFAULT_BRAIN_FILENAME = "bestBrain.dat";
     const int NUM_AI_CARS = 1000;
-    const int NUM_OBSTACLES = 30; // Target number of obstacles
     const float START_Y_POSITION = 100.0f;
-    const float OBSTACLE_REMOVAL_DISTANCE = 2000.0f; // Distance behind best car to remove obstacles
-    const float GENERATION_ZONE_START_Y = -550.0f;  // Y offset ahead for new obstacle spawns
-    const float GENERATION_ZONE_END_Y = -2000.0f; // Furthest Y offset for new obstacle spawns
+    // Obstacle sizes/gaps, chunk length, course start Y and target obstacles per chunk
+    const CourseLayout COURSE_LAYOUT = {{20.0f, 40.0f, 40.0f, 80.0f, 75.0f, 150.0f}, 1000.0f, -100.0f, 12};
+    const long long OBSTACLE_CHUNK_LOOKAHEAD = 2; // Chunks on the road ahead of the leader's; far beyond any sensor ray
+    const float CHUNK_RECYCLE_MARGIN = 300.0f;    // Distance behind the rear-most live car before a chunk is retired
+    const std::string SCENARIO_BANK_FILENAME = "backups/scenarios.dat";
+    const int SCENARIO_BANK_SIZE = 16;
+    const int SCENARIO_CHUNK_COUNT = 12;  // Enough for a full 60 s generation at max speed
+    const int SCENARIO_SUBSET_SIZE = 4;   // Scenarios rotated through during training
+    const uint64_t SCENARIO_BANK_SEED = 20240601;
+    const std::string CHECKPOINT_FILENAME = "backups/checkpoint.dat";
+    const int CHECKPOINT_INTERVAL = 5; // Generations between checkpoints (most work lost on a crash)
+    const float SIMULATION_TIME_LIMIT_SECONDS = 60.0f;
+    const float SIMULATION_TIME_STEP = 1.0f / 60.0f; // Same step as HeadlessWorld
+    const int MAX_SIMULATION_STEPS_PER_FRAME = 4;    // Slow frames drop time instead of spiralling
+    const std::vector<float> HALVING_RUNG_SECONDS = {4.0f, 12.0f}; // Then the full time limit
+    const float HALVING_PROMOTE_FRACTION = 0.25f;
+    const float PRUNE_CHECK_INTERVAL_SECONDS = 1.0f;
+    const int ROBUST_EVAL_SCENARIOS = 8;
+    const FitnessAggregation ROBUST_EVAL_AGGREGATION = FitnessAggregation::MEAN;
+    const float ROBUST_EVAL_QUANTILE = 0.25f; // Used when aggregating by quantile
+    // Islands: one per spare core, 64 genomes each, best 2 migrate every 5 island generations
+    const IslandSettings ISLAND_SETTINGS = {0, 64, 5, 2, 0.02f, 0.3f, 60.0f, 4};
 
     // --- Private Helper Methods ---
     void setupWindowAndViews();
@@ -122,24 +316,72 @@ private:
     void initializeSimulation();
 
     void processEvents();
+    void handleEvent(const sf::Event& event);
+    bool needsRedraw() const;
     void handleMenuKeyPress(const sf::Event::KeyPressed& keyEvent);
     void handleSimulationKeyPress(const sf::Event::KeyPressed& keyEvent);
 
     void updateMenu();
     void updateSimulation(sf::Time deltaTime);
+    bool stepSimulation(); // One fixed step; true when it ended the generation
+    GenerationEnd advanceGeneration(); // Moves every running car one step; the reason to end, if any
+    void endGeneration(GenerationEnd end); // Selection, breeding and the next generation's start
+    void prepareGenerationEvaluation(); // Cache lookups and merging of identical agents for a new generation
+    void finishGenerationEvaluation(bool cacheResults, float& averageFitness, float& maxFitness);
+    int promoteHalvingRung(); // Stops running cars outside the top fraction; returns cars still running
+    int pruneHopelessCars(); // Retires cars whose fitness upper bound cannot reach the top K; returns cars still running
+    size_t selectionKeepCount() const; // K: how many of this generation's best cars selection looks at
+    int countRetired(RetireReason reason) const;
     void updateFocus();
     void updateStatusPanel();
+    void updateDisplayedStatus(const WorldSnapshot& snapshot); // Render thread: snapshot status plus drawing stats
+    void countAliveCars();
+    int getFocusRank(int& rankedCount) const; // 1 = furthest ahead among the navigable cars
     void updateMutationRate();
+    float mutationRateForGeneration(int generation) const;
+    void speculateNextGeneration(); // Starts building offspring of the running leader (or the running mating pool) in the background
     void updateGraphData(float avgFit, float bestFit, float mutRate);
 
+    void startSimulationThread();
+    void stopSimulationThread(); // Joins; the simulation members are this thread's again afterwards
+    void simulationThreadLoop();
+    void publishSnapshot(); // Simulation thread: copies what the render thread draws
+    void toggleRecording();
+    void renderProfilerOverlay();
+    void dumpProfile(); // CSV of every recorded frame plus a JSON summary, written by persistenceWorker
+
     void renderMenu();
     void renderHelp();
     void renderSimulation();
-    void renderGraphs();
+    void renderObstacles(const WorldSnapshot& snapshot, const sf::FloatRect& visibleArea);
+    void renderGraphs(const WorldSnapshot& snapshot);
+    void buildGraphGeometry(const WorldSnapshot& snapshot);
 
     void resetGeneration();
-    void manageInfiniteObstacles(); // Create/destroy obstacles based on best car position
+    void manageInfiniteObstacles(); // Stream in chunks ahead of the leader, retire them behind the rear-most car
+    void startCourse(uint64_t seed, const Scenario* scenario = nullptr);
+    void spawnChunksUpTo(long long chunkIndex); // Blocks until every chunk up to chunkIndex is on the road
+    void startNextCourse(); // Picks the course for the current generation from courseMode
+    void setupScenarioBank();
+    void cycleCourseMode();
+    void trackConvergence(float bestFitness);
+    void toggleRobustEvaluation();
+    void cycleCrossoverMode();
+    std::string getSelectionName() const;
+    void captureMatingPool(); // Copies the generation's best brains before the cars are reset
+    // 'elite' followed by the best cars by 'carFitness', as breedGeneration expects them
+    void collectMatingPool(const NeuralNetwork& elite, const std::vector<float>& carFitness,
+                           std::vector<NeuralNetwork>& pool, std::vector<float>& poolFitness) const;
+    void startRobustEvaluation(); // Hands copies of this generation's genomes to scenarioEvaluator
+    void cancelRobustEvaluation(); // Skips the remaining tasks and waits for the running ones
+    bool robustEvaluationPending() const;
+    Car* selectRobustElite(); // Best car by fitness aggregated over several scenarios, or nullptr
+    void toggleIslandModel();
+    bool adoptIslandChampion(); // Replaces bestBrainOfGeneration with the island champion if it scores higher
+    void updateIslandGraphData();
     void saveBestBrain();
+    void saveCheckpoint();
+    bool resumeFromCheckpoint(); // Restores the full training state; false leaves the fresh state untouched
     void discardSavedBrain();
     void togglePause();
 
@@ -148,15 +390,9 @@ private:
     void stopManualNavigation();
 
     void populateCarVector(int N, float startY);
-    void generateInitialObstacles(int N, float minY, float maxY, float minW, float maxW, float minH, float maxH);
     void applyBrainsToGeneration(int N); // Apply best brain + mutations to cars
     int getLaneIndex(float xPos);
-    std::unique_ptr<Obstacle> generateSingleObstacle(
-        float minY, float maxY,
-        float minW, float maxW, float minH, float maxH,
-        const sf::Color& color,
-        float minVerticalGapAdjacentLane, float minVerticalGapSameLane,
-        int maxPlacementRetries = 25);
+    void spawnObstacle(const ObstacleSpec& spec);
 };
 
 #endif // GAME_HPP
\ No newline at end of file
@@ -0,0 +1,87 @@
+#ifndef GENERATION_PREPARER_HPP
+#define GENERATION_PREPARER_HPP
+
+#include "Network.hpp"
+#include "Selection.hpp"
+#include <vector>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+// Builds the next generation's offspring on a background thread while the current one runs.
+// The simulation calls prepare() with its current guess of the next elite (or prepareBred()
+// with its guess of the ranked mating pool); at the generation boundary take() or takeBred()
+// hands the finished buffer over if the guess was right. A newer request abandons any build
+// still in progress.
+class GenerationPreparer {
+public:
+    GenerationPreparer();
+    ~GenerationPreparer();
+
+    GenerationPreparer(const GenerationPreparer&) = delete;
+    GenerationPreparer& operator=(const GenerationPreparer&) = delete;
+
+    // Mutated clones of 'parent'
+    void prepare(const NeuralNetwork& parent, float mutationRate, size_t offspringCount);
+    // breedGeneration() over 'parents' (best first, ranked by 'fitness'), minus its first offspring,
+    // which is the best parent itself
+    void prepareBred(const std::vector<NeuralNetwork>& parents, const std::vector<float>& fitness,
+                     float mutationRate, const SelectionSettings& selection, size_t offspringCount);
+
+    // Swaps the buffer built from 'parent' at 'mutationRate' into 'offspring' (and the offspring
+    // genome hashes into 'hashes'). Waits for a matching build still in progress. The parent is
+    // matched by hash first and then weight by weight, so a hash collision is a miss.
+    bool take(const NeuralNetwork& parent, float mutationRate, std::vector<NeuralNetwork>& offspring, std::vector<uint64_t>& hashes);
+    // Same for a bred buffer: every parent must match, in the same order, with the same selection
+    bool takeBred(const std::vector<NeuralNetwork>& parents, float mutationRate, const SelectionSettings& selection,
+                  std::vector<NeuralNetwork>& offspring, std::vector<uint64_t>& hashes);
+
+    long long getHits() const { return hits; }
+    long long getMisses() const { return misses; }
+    float getLastBuildMs() const { return lastBuildMs.load(std::memory_order_relaxed); }
+
+private:
+    struct Request {
+        std::vector<NeuralNetwork> parents; // One parent: mutated clones; several: bred with 'selection'
+        std::vector<float> fitness;
+        uint64_t parentHash;                // All parents' genome hashes, in order
+        float mutationRate;
+        SelectionSettings selection;
+        size_t offspringCount;
+    };
+
+    std::optional<Request> pending;
+    bool isBuilding = false;
+    uint64_t buildingParentHash = 0;
+    float buildingMutationRate = -1.0f;
+    SelectionSettings buildingSelection;
+    uint64_t readyParentHash = 0;
+    std::vector<NeuralNetwork> readyParents;
+    float readyMutationRate = -1.0f;
+    SelectionSettings readySelection;
+    std::vector<NeuralNetwork> readyOffspring;
+    std::vector<uint64_t> readyHashes;
+    bool readyValid = false;
+
+    bool stopping = false;
+    std::atomic<uint64_t> requestSerial{0}; // Bumped by each request; a build for an older serial is abandoned
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable buildFinished;
+
+    long long hits = 0;
+    long long misses = 0;
+    std::atomic<float> lastBuildMs{0.0f};
+
+    std::thread worker;
+
+    void request(Request next);
+    bool takeMatching(const NeuralNetwork* parents, size_t parentCount, float mutationRate, const SelectionSettings& selection,
+                      std::vector<NeuralNetwork>& offspring, std::vector<uint64_t>& hashes);
+    void workerLoop();
+};
+
+#endif // GENERATION_PREPARER_HPP
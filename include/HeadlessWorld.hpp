@@ -0,0 +1,52 @@
+#ifndef HEADLESS_WORLD_HPP
+#define HEADLESS_WORLD_HPP
+
+#include "Road.hpp"
+#include "ObstacleGenerator.hpp"
+#include "ScenarioBank.hpp"
+#include <vector>
+#include <deque>
+#include <memory>
+
+class Car;
+class Obstacle;
+class NeuralNetwork;
+
+// Window-less copy of the simulation (one road, one car, streamed obstacles) that
+// scores a brain on a scenario using the regular Car/Road/Obstacle logic.
+// Each instance must only be used by one thread at a time.
+class HeadlessWorld {
+public:
+    HeadlessWorld(const Road& road, const CourseLayout& course);
+    ~HeadlessWorld();
+
+    // Drives one car with 'brain' on 'scenario' until it is damaged or maxSeconds of
+    // simulated time have passed, and returns its fitness.
+    float evaluate(const NeuralNetwork& brain, const Scenario& scenario, float maxSeconds);
+
+    long long getTicksSimulated() const { return ticksSimulated; }
+
+    static constexpr float TIME_STEP_SECONDS = 1.0f / 60.0f;
+    static constexpr float START_Y_POSITION = 100.0f;
+
+private:
+    Road road;
+    CourseLayout course;
+    ObstacleGenerator generator;
+    std::unique_ptr<Car> car;
+
+    std::vector<std::unique_ptr<Obstacle>> obstacles;
+    std::vector<Obstacle*> obstacleRawPtrs;
+    std::deque<std::pair<long long, size_t>> liveChunks; // (chunk index, obstacle count), in order
+    long long nextChunk = 0;
+    long long ticksSimulated = 0;
+
+    void streamChunks(const Scenario& scenario);
+    void loadChunk(const Scenario& scenario, long long chunkIndex);
+    void rebuildRawPointers();
+
+    static constexpr long long CHUNK_LOOKAHEAD = 1;
+    static constexpr float CHUNK_RECYCLE_MARGIN = 300.0f;
+};
+
+#endif // HEADLESS_WORLD_HPP
@@ -0,0 +1,49 @@
+#ifndef HISTORY_STORE_HPP
+#define HISTORY_STORE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Per-generation values for the graphs, kept for the whole run in bounded memory.
+// Samples go into buckets of 'bucketWidth' consecutive generations (min, max, sum);
+// once 'maxBuckets' are full, neighbouring pairs are merged and the width doubles.
+// A million-generation run is therefore still at most maxBuckets buckets, and push
+// is O(1) amortised. Every bucket except the last holds exactly bucketWidth samples.
+class HistoryStore {
+public:
+    struct Bucket {
+        float min;
+        float max;
+        double sum;
+        uint64_t count;
+
+        float mean() const { return count > 0 ? static_cast<float>(sum / static_cast<double>(count)) : 0.0f; }
+    };
+
+    explicit HistoryStore(size_t maxBuckets = 256);
+
+    void push(float value);
+    void clear();
+    // Replaces the contents with a saved state; false (and left empty) if it is inconsistent
+    bool restore(uint64_t bucketWidth, const std::vector<Bucket>& buckets);
+
+    const std::vector<Bucket>& getBuckets() const { return buckets; }
+    uint64_t getBucketWidth() const { return bucketWidth; }
+    uint64_t getSampleCount() const { return sampleCount; }
+    bool empty() const { return sampleCount == 0; }
+    float getMin() const { return minValue; }
+    float getMax() const { return maxValue; }
+
+private:
+    size_t maxBuckets;
+    uint64_t bucketWidth = 1;
+    uint64_t sampleCount = 0;
+    float minValue = 0.0f;
+    float maxValue = 0.0f;
+    std::vector<Bucket> buckets;
+
+    void mergePairs();
+};
+
+#endif // HISTORY_STORE_HPP
@@ -0,0 +1,105 @@
+#ifndef ISLAND_MODEL_HPP
+#define ISLAND_MODEL_HPP
+
+#include "Network.hpp"
+#include "HeadlessWorld.hpp"
+#include "SpscQueue.hpp"
+#include "Selection.hpp"
+#include <vector>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <future>
+#include <mutex>
+#include <atomic>
+#include <limits>
+
+class Road;
+
+struct IslandSettings {
+    int islandCount = 0;          // 0 = one per hardware thread, minus the render thread
+    int populationPerIsland = 64;
+    int migrationInterval = 5;    // Generations between migrations
+    int migrantCount = 2;         // Best genomes sent to the next island on each migration
+    float minMutationRate = 0.02f; // Islands get rates spread between these two
+    float maxMutationRate = 0.3f;
+    float maxSecondsPerRun = 60.0f;
+    int scenarioSubsetSize = 4;
+    SelectionSettings selection = multiParentSelection(CrossoverMode::UNIFORM);
+};
+
+// Island-model GA: several populations, each evolved headlessly on its own thread with
+// its own mutation rate. Every few generations an island sends its best genomes to the
+// next island in a ring through a lock-free mailbox.
+class IslandModel {
+public:
+    // 'bank' must outlive the model; every island starts from 'seedBrain'
+    IslandModel(const Road& road, const CourseLayout& course, const ScenarioBank& bank,
+                const NeuralNetwork& seedBrain, const IslandSettings& settings);
+    ~IslandModel();
+
+    IslandModel(const IslandModel&) = delete;
+    IslandModel& operator=(const IslandModel&) = delete;
+
+    size_t getIslandCount() const { return islands.size(); }
+    float getIslandBestFitness(size_t island) const; // Best of the island's latest generation
+    int getIslandGeneration(size_t island) const;
+    float getIslandMutationRate(size_t island) const { return islands[island]->mutationRate; }
+    long long getMigrationCount() const { return migrationCount.load(std::memory_order_relaxed); }
+
+    // Champions are compared by their mean fitness on the first scenarioSubsetSize bank
+    // scenarios (the ones every island trains on), so scores from different islands and
+    // generations are on the same measure
+    float getGlobalBestFitness() const; // Best common-set fitness any island has produced so far
+    bool copyGlobalBest(NeuralNetwork& out, float& fitness) const;
+
+    // Same measure for a genome from elsewhere, scored in the background on the judge world.
+    // A request is ignored while the previous score is still being computed. Both calls must come
+    // from one thread; takeCommonSetScore returns each finished score once, with the genome it belongs to.
+    void requestCommonSetScore(const NeuralNetwork& genome);
+    bool takeCommonSetScore(NeuralNetwork& genome, float& fitness);
+
+private:
+    struct Migrant {
+        float fitness = -std::numeric_limits<float>::infinity();
+        std::optional<NeuralNetwork> genome;
+    };
+
+    static constexpr size_t MAILBOX_CAPACITY = 8;
+
+    struct Island {
+        size_t index = 0;
+        float mutationRate = 0.0f;
+        std::unique_ptr<HeadlessWorld> world;
+        std::vector<NeuralNetwork> population; // population[0] is the elite
+        std::vector<NeuralNetwork> offspring;  // Next generation is bred here, then swapped in
+        SpscQueue<Migrant, MAILBOX_CAPACITY> inbox; // Written only by the previous island
+        std::atomic<float> bestFitness{-std::numeric_limits<float>::infinity()};
+        std::atomic<int> generation{0};
+        std::thread thread;
+    };
+
+    const ScenarioBank& bank;
+    IslandSettings settings;
+    std::vector<std::unique_ptr<Island>> islands;
+    std::atomic<bool> running{true};
+    std::atomic<long long> migrationCount{0};
+
+    mutable std::mutex globalBestMutex;
+    std::optional<NeuralNetwork> globalBestGenome;
+    float globalBestFitness = -std::numeric_limits<float>::infinity();
+
+    std::unique_ptr<HeadlessWorld> judgeWorld; // Scores outside genomes without touching an island's world
+    std::optional<NeuralNetwork> judgedGenome;  // Being scored by 'judgement', which alone uses judgeWorld
+    std::future<float> judgement;
+
+    void islandLoop(Island& island);
+    void stepGeneration(Island& island);
+    void emigrate(Island& island, const std::vector<size_t>& ranking, const std::vector<float>& fitness);
+    void immigrate(Island& island);
+    size_t commonSetSize() const;
+    float commonSetFitness(HeadlessWorld& world, const NeuralNetwork& genome) const;
+    void offerGlobalBest(const NeuralNetwork& genome, float fitness);
+};
+
+#endif // ISLAND_MODEL_HPP
@@ -5,6 +5,7 @@
 #include <cmath>
 #include <fstream>
 #include "Utils.hpp"
+#include <cstdint>
 
 // Represents one layer of the neural network
 class Level {
@@ -20,7 +21,7 @@ public:
     static const std::vector<float>& feedForward(const std::vector<float>& givenInputs, Level& level);
 
     // Save/Load Level data
-    void save(std::ofstream& file) const;
+    void save(std::ostream& file) const;
     void load(std::ifstream& file);
 
 private:
@@ -41,8 +42,20 @@ public:
     // Mutate the network's weights and biases
     static void mutate(NeuralNetwork& network, float amount = 1.0f);
 
+    // All biases and weights as one flat vector, level by level (biases first, then weights row by row)
+    std::vector<float> toGenome() const;
+    // Inverse of toGenome; fails if the genome size does not match this network's structure
+    bool fromGenome(const std::vector<float>& genome);
+    bool fromGenome(const float* genome, size_t genomeSize);
+    size_t getGenomeSize() const;
+    // Content hash (FNV-1a) of the structure and every weight/bias bit pattern
+    uint64_t getGenomeHash() const;
+    // Same structure and bit-identical weights/biases; confirms a getGenomeHash match
+    bool sameGenome(const NeuralNetwork& other) const;
+
     // Save/Load network
     bool saveToFile(const std::string& filename) const;
+    void saveToStream(std::ostream& stream) const; // Same bytes as saveToFile
     bool loadFromFile(const std::string& filename);
 };
 
@@ -14,10 +14,13 @@ public:
     sf::Color color;
     std::vector<sf::Vector2f> polygon;
     long long id;
+    int lane; // Lane index assigned at spawn (-1 if unknown)
 
-    Obstacle(float x, float y, float w, float h, sf::Color col = sf::Color(128, 128, 128));
+    Obstacle(float x, float y, float w, float h, sf::Color col = sf::Color(128, 128, 128), int laneIndex = -1);
 
     void draw(sf::RenderTarget& target) const;
+    // Same look from a plain description, for drawing from a WorldSnapshot
+    static void draw(sf::RenderTarget& target, sf::Vector2f position, float width, float height, sf::Color color);
     std::vector<sf::Vector2f> getPolygon() const;
 
     long long getId() const;
@@ -26,10 +29,8 @@ private:
     void updatePolygon();
     static std::atomic<long long> nextId;
 
-    sf::Texture texture;
-    sf::Sprite sprite;
-    bool textureLoaded = false;
-    void loadTexture(const std::string& filename);
+    // Shared by every obstacle and loaded on first draw, so spawning never touches the disk
+    static const sf::Texture* getSharedTexture();
 };
 
 #endif // OBSTACLE_HPP
\ No newline at end of file
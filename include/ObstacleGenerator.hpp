@@ -0,0 +1,104 @@
+#ifndef OBSTACLE_GENERATOR_HPP
+#define OBSTACLE_GENERATOR_HPP
+
+#include <vector>
+#include <map>
+#include <random>
+#include <optional>
+#include <cstdint>
+#include <cmath>
+
+// Plain description of an obstacle placement (no texture or polygon attached)
+struct ObstacleSpec {
+    float x;
+    float y;
+    float width;
+    float height;
+    int lane;
+};
+
+// Size limits and spacing rules used when placing obstacles
+struct ObstacleLayout {
+    float minWidth;
+    float maxWidth;
+    float minHeight;
+    float maxHeight;
+    float minVerticalGapAdjacentLane;
+    float minVerticalGapSameLane;
+};
+
+// The course is cut into fixed-length chunks; chunk k covers (startY - (k + 1) * chunkLength, startY - k * chunkLength]
+struct CourseLayout {
+    ObstacleLayout obstacles;
+    float chunkLength;
+    float startY;
+    int obstaclesPerChunk;
+
+    long long chunkIndexAt(float y) const { return static_cast<long long>(std::floor((startY - y) / chunkLength)); }
+    float chunkFrontY(long long chunkIndex) const { return startY - (chunkIndex + 1) * chunkLength; }
+    float chunkBackY(long long chunkIndex) const { return startY - chunkIndex * chunkLength; }
+};
+
+// Per-lane ordered set of occupied vertical intervals (keyed by center Y).
+// Gap checks only visit the intervals that can possibly overlap the candidate.
+class LaneIntervalIndex {
+public:
+    explicit LaneIntervalIndex(int laneCount = 0);
+
+    void reset(int laneCount);
+    void insert(int lane, float centerY, float height);
+    bool isClear(int lane, float top, float bottom, float gapSameLane, float gapAdjacentLane) const;
+    // If [top, bottom] is blocked, returns the bottom edge (further ahead) that clears every current conflict
+    std::optional<float> nextClearBottom(int lane, float top, float bottom,
+                                         float gapSameLane, float gapAdjacentLane) const;
+    void removeBehind(float y); // Drops every interval whose center is greater than y
+    size_t size() const;
+
+private:
+    std::vector<std::multimap<float, float>> lanes; // centerY -> halfHeight
+    std::vector<float> maxHalfHeights;
+
+    // Calls onConflict(intervalTop) for intervals of 'lane' closer than 'gap'; stops when it returns false
+    template <typename Fn>
+    bool visitConflicts(int lane, float top, float bottom, float gap, Fn onConflict) const;
+};
+
+class ObstacleGenerator {
+public:
+    ObstacleGenerator(float roadLeft, float roadWidth, int laneCount);
+
+    void seed(uint32_t value);
+    void clear();
+    void insert(const ObstacleSpec& spec);
+    void removeBehind(float y);
+    size_t size() const { return index.size(); }
+
+    // Random candidate within [minY, maxY]; each candidate check is O(log n)
+    std::optional<ObstacleSpec> sampleSingle(float minY, float maxY, const ObstacleLayout& layout,
+                                             int maxPlacementRetries = 25);
+
+    // Constructive Poisson-disk sampling along each lane (no rejection loop).
+    // Appends up to 'count' obstacles between minY and maxY to 'placed', records them in the index
+    // and returns how many were added.
+    size_t sampleCourse(int count, float minY, float maxY, const ObstacleLayout& layout,
+                        std::vector<ObstacleSpec>& placed);
+
+    // Deterministic content of one chunk: depends only on (courseSeed, chunkIndex).
+    // Obstacles keep half the same-lane gap away from chunk edges so chunks never conflict.
+    size_t sampleChunk(uint64_t courseSeed, long long chunkIndex, const CourseLayout& course,
+                       std::vector<ObstacleSpec>& placed);
+    static uint32_t chunkSeed(uint64_t courseSeed, long long chunkIndex);
+
+private:
+    float roadLeft;
+    float roadWidth;
+    int laneCount;
+    float laneWidth;
+    LaneIntervalIndex index;
+    std::mt19937 rng;
+
+    float randomFloat(float min, float max);
+    float randomXInLane(int lane, float width);
+};
+
+#endif // OBSTACLE_GENERATOR_HPP
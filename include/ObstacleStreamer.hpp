@@ -0,0 +1,71 @@
+#ifndef OBSTACLE_STREAMER_HPP
+#define OBSTACLE_STREAMER_HPP
+
+#include "ObstacleGenerator.hpp"
+#include "ScenarioBank.hpp"
+#include "SpscQueue.hpp"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+struct ObstacleChunk {
+    long long index = -1;
+    uint64_t epoch = 0;
+    std::vector<ObstacleSpec> specs;
+};
+
+// Generates course chunks on a background worker ahead of the leading car.
+// The simulation thread only requests, takes and recycles chunks; it never places obstacles.
+// The worker sleeps until there is something to generate.
+class ObstacleStreamer {
+public:
+    ObstacleStreamer(float roadLeft, float roadWidth, int laneCount, const CourseLayout& course);
+    ~ObstacleStreamer();
+
+    ObstacleStreamer(const ObstacleStreamer&) = delete;
+    ObstacleStreamer& operator=(const ObstacleStreamer&) = delete;
+
+    // Start a new course. Chunks queued for the previous course are dropped on poll.
+    // With a scenario, its pre-generated chunks are served first (it must outlive the course).
+    void restart(uint64_t courseSeed, long long initialChunks, const Scenario* scenario = nullptr);
+    // Ask the worker to have every chunk up to (and including) chunkIndex ready
+    void requestUpTo(long long chunkIndex);
+    // Pops the next ready chunk of the current course (chunks arrive in index order)
+    bool poll(ObstacleChunk& chunk);
+    // Like poll(), but blocks until the worker has the next chunk ready. The chunk must have been requested.
+    bool waitForChunk(ObstacleChunk& chunk);
+    // Hands a retired chunk back so the worker can reuse its storage
+    void recycle(ObstacleChunk&& chunk);
+
+    const CourseLayout& getCourse() const { return course; }
+    uint64_t getCourseSeed() const { return courseSeed.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t QUEUE_CAPACITY = 32;
+
+    CourseLayout course;
+    ObstacleGenerator generator; // Only touched by the worker thread
+
+    SpscQueue<ObstacleChunk, QUEUE_CAPACITY> readyChunks;    // worker -> simulation
+    SpscQueue<ObstacleChunk, QUEUE_CAPACITY> recycledChunks; // simulation -> worker
+
+    std::atomic<uint64_t> courseSeed{0};
+    std::atomic<const Scenario*> courseScenario{nullptr};
+    std::atomic<uint64_t> currentEpoch{0};
+    std::atomic<long long> requestedChunk{-1};
+    std::atomic<bool> running{true};
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;  // worker waits for requests and free queue slots
+    std::mutex readyMutex;
+    std::condition_variable readyCondition; // waitForChunk() waits for the worker's next chunk
+    std::thread worker;
+
+    void workerLoop();
+    void wakeWorker();
+};
+
+#endif // OBSTACLE_STREAMER_HPP
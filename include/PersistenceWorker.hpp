@@ -0,0 +1,52 @@
+#ifndef PERSISTENCE_WORKER_HPP
+#define PERSISTENCE_WORKER_HPP
+
+#include <string>
+#include <functional>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// Writes files on a background thread so the simulation never waits for the disk.
+// Each save is a snapshot plus a serializer; a save to a file that still has one
+// pending replaces it (coalescing), so a slow disk only ever writes the newest data.
+// Every write goes through writeFileAtomic (temp file, fsync, rename).
+class PersistenceWorker {
+public:
+    using Serializer = std::function<std::string()>; // Runs on the worker; must own its snapshot
+
+    PersistenceWorker();
+    ~PersistenceWorker(); // Writes whatever is still pending before returning
+
+    PersistenceWorker(const PersistenceWorker&) = delete;
+    PersistenceWorker& operator=(const PersistenceWorker&) = delete;
+
+    void save(const std::string& filename, Serializer serializer);
+    void flush(); // Blocks until every queued save has been written
+
+    long long getWritesCompleted() const { return writesCompleted.load(std::memory_order_relaxed); }
+    long long getSavesCoalesced() const { return savesCoalesced.load(std::memory_order_relaxed); }
+    float getLastWriteMs() const { return lastWriteMs.load(std::memory_order_relaxed); }
+    float getMaxWriteMs() const { return maxWriteMs.load(std::memory_order_relaxed); }
+
+private:
+    std::map<std::string, Serializer> pending; // Newest save per file
+    bool writing = false;
+    bool stopping = false;
+    std::mutex queueMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable queueDrained;
+
+    std::atomic<long long> writesCompleted{0};
+    std::atomic<long long> savesCoalesced{0};
+    std::atomic<float> lastWriteMs{0.0f};
+    std::atomic<float> maxWriteMs{0.0f};
+
+    std::thread worker;
+
+    void workerLoop();
+};
+
+#endif // PERSISTENCE_WORKER_HPP
@@ -0,0 +1,36 @@
+#ifndef POPULATION_RENDERER_HPP
+#define POPULATION_RENDERER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstddef>
+#include "WorldSnapshot.hpp"
+
+// Draws a whole population as one vertex array of textured quads (two triangles each),
+// so 1000 cars cost one draw call and one texture bind instead of one sprite each.
+// Cars come as poses from a WorldSnapshot, so drawing never touches the live simulation.
+// Damage tinting lives in the vertex colours; sensors are drawn separately by the caller.
+// Cars are kept sorted by Y, so only the slice inside the visible band is ever touched.
+class PopulationRenderer {
+public:
+    // Skips cars[excluded] (drawn on top by the caller) and cars outside 'visibleArea'
+    void draw(sf::RenderTarget& target, const std::vector<CarPose>& cars, int excluded,
+              const sf::FloatRect& visibleArea);
+    void drawSingle(sf::RenderTarget& target, const CarPose& car);
+
+    size_t getCarsDrawn() const { return carsDrawn; }
+    size_t getCarsCulled() const { return carsCulled; }
+
+private:
+    sf::VertexArray vertices{sf::PrimitiveType::Triangles}; // Kept between frames to reuse its storage
+    sf::VertexArray singleCar{sf::PrimitiveType::Triangles};
+    std::vector<size_t> carsByY; // Indices into the population, nearly sorted from one frame to the next
+    size_t carsDrawn = 0;
+    size_t carsCulled = 0;
+
+    void sortByY(const std::vector<CarPose>& cars);
+
+    static void appendCar(sf::VertexArray& into, const CarPose& car, sf::Vector2f textureSize);
+};
+
+#endif // POPULATION_RENDERER_HPP
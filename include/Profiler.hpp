@@ -0,0 +1,137 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Phases timed by PROFILE_SCOPE. The simulation thread records the first group, the window thread the rest.
+enum class ProfilePhase {
+    SENSORS,            // Car::update: ray casting
+    CONTROLS,           // Car::update: network inference and control decisions
+    MOVE,               // Car::update: physics, lane/fitness bookkeeping and stop checks
+    COLLISION,          // Car::update: final collision test
+    OBSTACLES,          // Streaming chunks in and retiring them
+    GENETIC_ALGORITHM,  // Halving, pruning, speculation and the generation boundary
+    SNAPSHOT,           // Copying the world for the window thread
+    RENDER_PANELS,      // Status text and graphs
+    RENDER_WORLD,       // Road, obstacles, cars and sensor
+    RENDER_NETWORK,     // Network visualiser and the profiler overlay
+    PRESENT,            // Frame capture and window.display()
+    COUNT
+};
+
+enum class ProfileTrack { SIMULATION, RENDER, COUNT };
+
+// Per-phase times of the last FRAME_CAPACITY frames of each thread, kept in rings.
+// A thread records only after attachThread(); Car::update also runs on headless worker
+// threads, and there a scope costs one thread-local check. Each thread adds into its own
+// current frame without locking; endFrame() moves it into the ring under the track's mutex.
+// Frame totals are always recorded; the phase scopes exist only when ENABLE_PROFILER is
+// defined (CMake option of the same name), so they can be compiled out entirely.
+class Profiler {
+public:
+    static constexpr size_t PHASE_COUNT = static_cast<size_t>(ProfilePhase::COUNT);
+    static constexpr size_t TRACK_COUNT = static_cast<size_t>(ProfileTrack::COUNT);
+    static constexpr size_t FRAME_CAPACITY = 600; // Ten seconds at 60 frames per second
+    static constexpr size_t TOTAL = PHASE_COUNT;  // Index of the frame total in statsOf
+
+    struct Frame {
+        uint64_t number = 0;
+        float totalMs = 0.0f;
+        std::array<float, PHASE_COUNT> phaseMs{};
+    };
+    struct Stats {
+        float p50 = 0.0f;
+        float p99 = 0.0f;
+        float mean = 0.0f;
+    };
+    using Recording = std::array<std::vector<Frame>, TRACK_COUNT>; // Oldest frame first
+
+    static Profiler& instance();
+    static const char* phaseName(ProfilePhase phase);  // For the overlay
+    static const char* phaseKey(ProfilePhase phase);   // For CSV columns and JSON keys
+    static const char* trackKey(ProfileTrack track);
+    static ProfileTrack trackOf(ProfilePhase phase);
+
+    void attachThread(ProfileTrack track);
+    void detachThread();
+    static bool isThreadAttached() { return threadTrack != nullptr; }
+
+    void beginFrame(); // Calling thread's track
+    void endFrame();
+    void add(ProfilePhase phase, float milliseconds);
+
+    Recording getRecording() const;
+    static Stats statsOf(const std::vector<Frame>& frames, size_t phase); // phase == TOTAL for frame totals
+    static std::string toCsv(const Recording& recording);
+    static std::string toJson(const Recording& recording);
+
+private:
+    struct Track {
+        mutable std::mutex mutex;
+        std::vector<Frame> ring; // Guarded by mutex
+        size_t next = 0;         // Guarded by mutex
+        uint64_t frameCount = 0; // Guarded by mutex
+        Frame current;           // Owning thread only
+        std::chrono::steady_clock::time_point frameStart;
+        bool inFrame = false;
+    };
+
+    std::array<Track, TRACK_COUNT> tracks;
+    static thread_local Track* threadTrack;
+
+    Profiler() = default;
+};
+
+// Times its scope (or each part of it, via switchTo) into the calling thread's current frame
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfilePhase phase)
+        : phase(phase), active(Profiler::isThreadAttached())
+    {
+        if (active) start = std::chrono::steady_clock::now();
+    }
+    ~ProfileScope() {
+        if (active) Profiler::instance().add(phase, elapsedMs(std::chrono::steady_clock::now()));
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    // Ends the current phase and starts the next with one clock read
+    void switchTo(ProfilePhase next) {
+        if (active) {
+            const auto now = std::chrono::steady_clock::now();
+            Profiler::instance().add(phase, elapsedMs(now));
+            start = now;
+        }
+        phase = next;
+    }
+
+private:
+    ProfilePhase phase;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+
+    float elapsedMs(std::chrono::steady_clock::time_point now) const {
+        return std::chrono::duration<float, std::milli>(now - start).count();
+    }
+};
+
+#ifdef ENABLE_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(phase) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(phase)
+#define PROFILE_SCOPE_NAMED(name, phase) ProfileScope name(phase)
+#define PROFILE_SWITCH(name, phase) name.switchTo(phase)
+#else
+#define PROFILE_SCOPE(phase) ((void)0)
+#define PROFILE_SCOPE_NAMED(name, phase) ((void)0)
+#define PROFILE_SWITCH(name, phase) ((void)0)
+#endif
+
+#endif // PROFILER_HPP
@@ -21,11 +21,21 @@ public:
 
     Road(float centerX, float roadWidth, int lanes = 3);
     float getLaneCenter(int laneIndex) const;
-    void draw(sf::RenderTarget& target);
+    // Draws only the part of the road inside 'visibleArea'
+    void draw(sf::RenderTarget& target, const sf::FloatRect& visibleArea);
     int getLaneIndex(float xPos);
 
 private:
+    static constexpr float DASH_LENGTH = 20.0f;
+    static constexpr float GAP_LENGTH = 15.0f;
+
+    // Lane dashes for a whole number of dash periods starting at y = 0, built once and
+    // translated to the view; rebuilt only when the view grows taller than the tile.
+    sf::VertexArray laneDashTile{sf::PrimitiveType::Lines};
+    float laneDashTileLength = 0.0f;
+
     void setupBorders();
+    void buildLaneDashTile(float minLength);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef SCENARIO_BANK_HPP
+#define SCENARIO_BANK_HPP
+
+#include "ObstacleGenerator.hpp"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// One reusable obstacle course: its seed plus the pre-generated leading chunks
+struct Scenario {
+    uint32_t id = 0;
+    uint64_t seed = 0;
+    std::vector<std::vector<ObstacleSpec>> chunks;
+
+    // Pre-generated chunk, or nullptr when the course must be extended from the seed
+    const std::vector<ObstacleSpec>* findChunk(long long chunkIndex) const {
+        if (chunkIndex < 0 || chunkIndex >= static_cast<long long>(chunks.size())) return nullptr;
+        return &chunks[chunkIndex];
+    }
+};
+
+// Fixed set of courses generated once (or loaded from disk) and referenced by ID,
+// so generations can be evaluated on the same layouts (common random numbers).
+// The bank is immutable after generate/load and may be read from any thread.
+class ScenarioBank {
+public:
+    ScenarioBank(float roadLeft, float roadWidth, int laneCount, const CourseLayout& course);
+
+    void generate(int scenarioCount, int chunksPerScenario, uint64_t baseSeed);
+    std::string serialize() const;
+    // Replaces the file atomically (temp file + rename) with serialize()
+    bool saveToFile(const std::string& filename) const;
+    // Fails, leaving the bank unchanged, if the file is corrupt or was made for another road/course
+    bool loadFromFile(const std::string& filename);
+
+    size_t size() const { return scenarios.size(); }
+    const Scenario& get(uint32_t id) const { return scenarios.at(id); }
+    // Rotates through the first 'subsetSize' scenarios, one per generation
+    uint32_t scenarioForGeneration(int generation, int subsetSize) const;
+
+private:
+    float roadLeft;
+    float roadWidth;
+    int laneCount;
+    CourseLayout course;
+    std::vector<Scenario> scenarios;
+
+    static constexpr uint32_t FILE_MAGIC = 0x42434453; // "SDCB"
+    static constexpr uint32_t FILE_VERSION = 2; // 2: header also records obstaclesPerChunk and the obstacle layout
+    static constexpr uint64_t MAX_SCENARIOS = 1u << 16;
+    static constexpr uint64_t MAX_CHUNKS_PER_SCENARIO = 1u << 16;
+};
+
+#endif // SCENARIO_BANK_HPP
@@ -0,0 +1,44 @@
+#ifndef SCENARIO_EVALUATOR_HPP
+#define SCENARIO_EVALUATOR_HPP
+
+#include "HeadlessWorld.hpp"
+#include "WorkerPool.hpp"
+#include <vector>
+#include <memory>
+#include <atomic>
+
+class Road;
+class NeuralNetwork;
+
+enum class FitnessAggregation {
+    MEAN,
+    QUANTILE
+};
+
+// Scores genomes on several scenarios in parallel: one HeadlessWorld per pool worker,
+// one task per (genome, scenario) pair.
+class ScenarioEvaluator {
+public:
+    ScenarioEvaluator(const Road& road, const CourseLayout& course, size_t workerCount = 0);
+
+    // Returns one aggregated fitness per genome. With QUANTILE, 'quantile' in [0, 1]
+    // picks the per-genome fitness at that rank (0 = worst scenario, 0.5 = median).
+    // Once '*cancelled' is set, tasks not yet started are skipped (their genomes score -inf).
+    std::vector<float> evaluate(const std::vector<const NeuralNetwork*>& genomes,
+                                const std::vector<const Scenario*>& scenarios,
+                                float maxSeconds,
+                                FitnessAggregation aggregation = FitnessAggregation::MEAN,
+                                float quantile = 0.5f,
+                                const std::atomic<bool>* cancelled = nullptr);
+
+    size_t getWorkerCount() const { return pool.getWorkerCount(); }
+    long long getTicksSimulated() const;
+
+    static float aggregate(std::vector<float> values, FitnessAggregation aggregation, float quantile);
+
+private:
+    WorkerPool pool;
+    std::vector<std::unique_ptr<HeadlessWorld>> worlds; // Indexed by pool worker
+};
+
+#endif // SCENARIO_EVALUATOR_HPP
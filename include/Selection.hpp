@@ -0,0 +1,46 @@
+#ifndef SELECTION_HPP
+#define SELECTION_HPP
+
+#include "Network.hpp"
+#include <vector>
+#include <cstddef>
+
+enum class CrossoverMode {
+    NONE,       // Offspring are mutated clones of one parent
+    UNIFORM,    // Each bias/weight taken from either parent
+    LAYER_WISE  // Each whole level taken from either parent
+};
+
+struct SelectionSettings {
+    int eliteCount = 1;       // Best genomes carried over unchanged
+    int matingPoolSize = 1;   // Parents are drawn from this many of the best; 1 = the classic elite-clone scheme
+    int tournamentSize = 3;
+    CrossoverMode crossover = CrossoverMode::NONE;
+    float crossoverFraction = 0.5f; // Share of the non-elite offspring made by crossover
+    // Mutation strength of each operator, as a multiple of the generation's mutation rate
+    float crossoverMutationScale = 0.5f;
+    float cloneMutationScale = 1.0f;
+};
+
+// Multi-parent preset: two elites, tournaments among the best 16, half the offspring by crossover
+SelectionSettings multiParentSelection(CrossoverMode crossover);
+
+// Mutation rate for 'generation': decays exponentially from 'initialRate' towards 'minRate'
+float scheduledMutationRate(float initialRate, float minRate, float decayFactor, int generation);
+
+// Indices of the 'count' fittest entries, best first (partial sort)
+std::vector<size_t> selectTopIndices(const std::vector<float>& fitness, size_t count);
+// Fittest of 'tournamentSize' random picks from 'candidates'
+size_t tournamentSelect(const std::vector<size_t>& candidates, const std::vector<float>& fitness, int tournamentSize);
+
+// Both parents and the child must share one structure; the child's storage is reused
+void crossoverUniform(const NeuralNetwork& a, const NeuralNetwork& b, NeuralNetwork& child);
+void crossoverLayerWise(const NeuralNetwork& a, const NeuralNetwork& b, NeuralNetwork& child);
+
+// Fills 'offspring' (which keeps its size) from 'parents' scored by 'fitness'. offspring[0..eliteCount)
+// are the best parents unchanged; the rest are crossovers or clones of tournament winners, mutated
+// at their operator's share of 'mutationRate'. 'parents' and 'offspring' must not alias.
+void breedGeneration(const std::vector<NeuralNetwork>& parents, const std::vector<float>& fitness,
+                     float mutationRate, const SelectionSettings& settings, std::vector<NeuralNetwork>& offspring);
+
+#endif // SELECTION_HPP
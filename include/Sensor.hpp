@@ -29,7 +29,7 @@ public:
     int getRayCount() { return rayCount; }
     void update(const std::vector<std::pair<sf::Vector2f, sf::Vector2f>>& roadBorders,
                 const std::vector<Obstacle*>& obstacles);
-    void draw(sf::RenderTarget& target);
+    void appendRayVertices(std::vector<sf::Vertex>& lines) const; // Pairs for a Lines primitive
 
 private:
     void castRays();
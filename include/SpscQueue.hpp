@@ -0,0 +1,54 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+template <typename T, size_t Capacity>
+class SpscQueue {
+public:
+    // Producer side. Returns false (and leaves 'item' untouched) when the queue is full.
+    bool push(T&& item) {
+        const size_t currentTail = tail.load(std::memory_order_relaxed);
+        const size_t nextTail = increment(currentTail);
+        if (nextTail == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        slots[currentTail] = std::move(item);
+        tail.store(nextTail, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when there is nothing to pop.
+    bool pop(T& item) {
+        const size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(slots[currentHead]);
+        head.store(increment(currentHead), std::memory_order_release);
+        return true;
+    }
+
+    bool full() const {
+        return increment(tail.load(std::memory_order_acquire)) == head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t SLOT_COUNT = Capacity + 1; // One slot stays free to tell full from empty
+
+    static size_t increment(size_t index) { return (index + 1) % SLOT_COUNT; }
+
+    std::array<T, SLOT_COUNT> slots;
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+};
+
+#endif // SPSC_QUEUE_HPP
@@ -0,0 +1,45 @@
+#ifndef TRAINING_CHECKPOINT_HPP
+#define TRAINING_CHECKPOINT_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "HistoryStore.hpp"
+
+// Everything needed to continue a training run where it stopped, taken at a generation
+// boundary: the prepared population of the next generation, the elite it was bred from,
+// counters, graph histories, the main thread's RNG state and the course being driven.
+struct TrainingCheckpoint {
+    int32_t generationCount = 1;
+    float currentMutationRate = 0.0f;
+    int32_t courseMode = 0;
+    int32_t currentScenarioId = -1;
+    uint64_t courseSeed = 0;
+    uint64_t scenarioBankSeed = 0;
+
+    int32_t convergenceStartGeneration = 1;
+    int32_t targetReachedGeneration = -1;
+    float targetReachedSeconds = 0.0f;
+    float convergenceElapsedSeconds = 0.0f;
+
+    std::vector<int32_t> networkStructure;
+    std::vector<float> eliteGenome;
+    std::vector<std::vector<float>> populationGenomes; // One per car, in car order
+
+    HistoryStore averageFitnessHistory;
+    HistoryStore bestFitnessHistory;
+    HistoryStore mutationRateHistory;
+
+    std::string rngState;
+
+    std::string serialize() const;
+    // Replaces the file atomically (temp file + rename) with serialize()
+    bool saveToFile(const std::string& filename) const;
+    bool loadFromFile(const std::string& filename);
+
+private:
+    static constexpr uint32_t FILE_MAGIC = 0x4B434453; // "SDCK"
+    static constexpr uint32_t FILE_VERSION = 2; // 2: histories saved as buckets; 1 (raw samples) still loads
+};
+
+#endif // TRAINING_CHECKPOINT_HPP
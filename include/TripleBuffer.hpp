@@ -0,0 +1,44 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+
+// Single-producer, single-consumer exchange of the latest value without locks or waiting.
+// The writer fills writeSlot() and publish()es it; the reader's read() returns the most
+// recently published value, skipping any it was too slow to see. Each side owns one slot
+// and the third is swapped between them through one atomic index. Slots are reused, so
+// a written slot still holds what was published into it two publishes ago.
+template <typename T>
+class TripleBuffer {
+public:
+    T& writeSlot() { return slots[writeIndex]; }
+
+    void publish() {
+        const unsigned previous = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Reader: true when something was published since the last read()
+    bool hasUnread() const { return middle.load(std::memory_order_relaxed) & FRESH; }
+
+    // Stays valid until the next read()
+    const T& read() {
+        if (middle.load(std::memory_order_relaxed) & FRESH) {
+            const unsigned previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+            readIndex = previous & INDEX_MASK;
+        }
+        return slots[readIndex];
+    }
+
+private:
+    static constexpr unsigned INDEX_MASK = 3;
+    static constexpr unsigned FRESH = 4; // Set when the middle slot holds a value the reader has not taken
+
+    std::array<T, 3> slots;
+    unsigned writeIndex = 0;             // Writer thread only
+    unsigned readIndex = 1;              // Reader thread only
+    std::atomic<unsigned> middle{2};
+};
+
+#endif // TRIPLE_BUFFER_HPP
@@ -6,6 +6,7 @@
 #include <optional>
 #include <random>
 #include <cstdint>
+#include <string>
 
 struct IntersectionData {
     sf::Vector2f point;
@@ -27,4 +28,8 @@ sf::Color getRandomColor();
 float getRandomFloat(float min, float max);
 int getRandomInt(int min, int max);
 
+// State of the calling thread's random engine, for checkpoints
+std::string getRandomState();
+bool setRandomState(const std::string& state);
+
 #endif // UTILS_HPP
\ No newline at end of file
@@ -2,22 +2,55 @@
 #define VISUALIZER_HPP
 
 #include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstddef>
 #include "Network.hpp" // Include Network definition
 
+// Draws a neural network in retained mode: node and edge geometry is built once per
+// topology (layer sizes and panel rectangle), and each frame only rewrites the vertex
+// colours from the current weights, biases and activations. Everything is three draw
+// calls (edges, nodes, output labels) however wide the network is.
 class Visualizer {
 public:
-    // Static method to draw the neural network
-    static void drawNetwork(sf::RenderTarget& ctx, const NeuralNetwork& network, const sf::Font& font,
-                            float x, float y, float width, float height);
+    void drawNetwork(sf::RenderTarget& ctx, const NeuralNetwork& network, const sf::Font& font,
+                     float x, float y, float width, float height);
+
+    size_t getEdgeCount() const { return edges.getVertexCount() / 2; }
 
 private:
-    // Static helper to draw a single level
-    static void drawLevel(sf::RenderTarget& ctx, const Level& level, const sf::Font& font,
-                          float left, float top, float width, float height,
-                          const std::vector<std::string>& outputLabels);
+    enum class NodeValue { INPUT, OUTPUT, BIAS };
+
+    // A run of node vertices whose colour follows one value of one level
+    struct ColorSlot {
+        size_t firstVertex;
+        size_t vertexCount;
+        size_t level;
+        size_t index;
+        NodeValue value;
+    };
+
+    sf::VertexArray edges{sf::PrimitiveType::Lines};
+    sf::VertexArray nodes{sf::PrimitiveType::Triangles};
+    std::vector<ColorSlot> colorSlots;
+    std::vector<sf::Text> labels;
+
+    // What the geometry was built for
+    std::vector<size_t> builtLayerSizes;
+    sf::FloatRect builtArea;
+    const sf::Font* builtFont = nullptr;
+
+    bool needsRebuild(const NeuralNetwork& network, const sf::Font& font, const sf::FloatRect& area) const;
+    void build(const NeuralNetwork& network, const sf::Font& font, const sf::FloatRect& area);
+    void buildLevel(size_t levelIndex, const Level& level, const sf::Font& font,
+                    float left, float top, float width, float height,
+                    const std::vector<std::string>& outputLabels);
+    void updateColors(const NeuralNetwork& network);
+
+    // Appends a filled disc (or a ring when innerRadius > 0) as triangles; returns its first vertex
+    size_t appendCircle(sf::Vector2f center, float innerRadius, float outerRadius, sf::Color color);
 
     // Static helper to get node x-coordinate
     static float getNodeX(int nodeCount, int index, float left, float right);
 };
 
-#endif // VISUALIZER_HPP
\ No newline at end of file
+#endif // VISUALIZER_HPP
@@ -0,0 +1,45 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <cstddef>
+
+// Fixed set of persistent threads that run batches of independent tasks.
+// Tasks are pulled from a shared counter, so uneven task lengths balance themselves.
+class WorkerPool {
+public:
+    // task(taskIndex, workerIndex); workerIndex is stable per thread and < getWorkerCount()
+    using Task = std::function<void(size_t, size_t)>;
+
+    explicit WorkerPool(size_t workerCount = 0); // 0 = one per hardware thread
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Runs task(0..taskCount-1) across the pool and blocks until all have finished
+    void run(size_t taskCount, const Task& task);
+    size_t getWorkerCount() const { return threads.size(); }
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex batchMutex;
+    std::condition_variable batchStarted;
+    std::condition_variable batchFinished;
+
+    const Task* currentTask = nullptr;
+    size_t currentTaskCount = 0;
+    std::atomic<size_t> nextTaskIndex{0};
+    size_t batchId = 0;
+    size_t activeWorkers = 0;
+    bool stopping = false;
+
+    void workerLoop(size_t workerIndex);
+};
+
+#endif // WORKER_POOL_HPP
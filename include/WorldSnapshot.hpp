@@ -0,0 +1,62 @@
+#ifndef WORLD_SNAPSHOT_HPP
+#define WORLD_SNAPSHOT_HPP
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <string>
+#include <optional>
+#include <cstdint>
+#include "Network.hpp"
+#include "HistoryStore.hpp"
+
+// What the render thread needs to draw one car
+struct CarPose {
+    sf::Vector2f position;
+    float angle; // Radians, as in Car
+    float width;
+    float height;
+    sf::Color color;
+};
+
+struct ObstaclePose {
+    sf::Vector2f position;
+    float width;
+    float height;
+    sf::Color color;
+};
+
+// A course chunk and how many of the following obstacles came from it
+struct ChunkSpan {
+    long long index;
+    size_t obstacleCount;
+};
+
+// Everything the render thread draws, copied out by the simulation thread after its steps.
+// Slots are reused through a TripleBuffer, so vectors keep their capacity; the histories
+// and status text are only copied when their version differs from the slot's.
+struct WorldSnapshot {
+    std::vector<CarPose> cars;    // Running cars plus the focused one
+    int focusedCar = -1;          // Index into cars
+    std::vector<sf::Vertex> focusedSensor; // Lines
+    float focusedSensorReach = 0.0f;
+
+    std::vector<ObstaclePose> obstacles; // In chunk order
+    std::vector<ChunkSpan> chunks;
+
+    std::optional<NeuralNetwork> focusedBrain; // Weights and activations of the focused car
+    bool hasFocusedBrain = false;
+
+    uint64_t historyVersion = 0;
+    HistoryStore averageFitnessHistory;
+    HistoryStore bestFitnessHistory;
+    HistoryStore mutationRateHistory;
+    std::vector<HistoryStore> islandBestHistory;
+    HistoryStore islandGlobalBestHistory;
+    bool islandModelActive = false;
+
+    uint64_t statusVersion = 0;
+    std::string status;
+    bool paused = false; // While paused, snapshots are only published when something changed
+};
+
+#endif // WORLD_SNAPSHOT_HPP
@@ -1,8 +1,62 @@
 #include "Game.hpp" // Inclui a nova classe Game
+#include "Car.hpp"
+#include "DistributedTraining.hpp"
+#include "EvolutionStrategy.hpp"
 #include <iostream>
+#include <string>
 
-int main() {
+// Same structure the windowed trainer builds: one input per sensor ray, 12 hidden, 4 outputs
+static std::vector<int> defaultNetworkStructure() {
+    Car tempCar(0, 0, 30, 50, ControlType::AI);
+    int sensorRays = tempCar.getSensorRayCount();
+    if (sensorRays <= 0) sensorRays = 5;
+    return {sensorRays, 12, 4};
+}
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << "                         open the simulator\n"
+              << "       " << program << " --coordinator <workers> [generations]\n"
+              << "       " << program << " --scaling <maxWorkers> [generations]\n"
+              << "       " << program << " --es <workers> [iterations]\n"
+              << "       " << program << " --es-compare <targetFitness> [seconds]\n"
+              << "       " << program << " --worker <socket>        (started by the coordinator)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
     try {
+        const std::string mode = argc > 1 ? argv[1] : "";
+        if (mode == "--worker" && argc > 2) {
+            return runTrainingWorker(argv[2]);
+        }
+        if ((mode == "--coordinator" || mode == "--scaling") && argc > 2) {
+            DistributedSettings settings;
+            settings.executablePath = argv[0];
+            settings.workerCount = std::max(1, std::stoi(argv[2]));
+            if (argc > 3) settings.generations = std::max(1, std::stoi(argv[3]));
+            if (mode == "--scaling") {
+                if (argc <= 3) settings.generations = 5;
+                TrainingCoordinator::runScalingReport(settings, defaultNetworkStructure(), settings.workerCount);
+                return EXIT_SUCCESS;
+            }
+            TrainingCoordinator coordinator(settings, defaultNetworkStructure());
+            return coordinator.run() ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        if (mode == "--es" && argc > 2) {
+            DistributedSettings settings;
+            settings.workerCount = std::max(1, std::stoi(argv[2]));
+            const int iterations = argc > 3 ? std::max(1, std::stoi(argv[3])) : 100;
+            return EvolutionStrategy::runTraining(settings, defaultNetworkStructure(), iterations) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        if (mode == "--es-compare" && argc > 2) {
+            const float timeLimit = argc > 3 ? std::stof(argv[3]) : 300.0f;
+            EvolutionStrategy::runComparison(DistributedSettings{}, defaultNetworkStructure(), std::stof(argv[2]), timeLimit);
+            return EXIT_SUCCESS;
+        }
+        if (!mode.empty()) {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+
         Game game; // Cria a instância do jogo
         game.run(); // Inicia o loop principal do jogo
     } catch (const std::exception& e) {
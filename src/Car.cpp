@@ -2,13 +2,14 @@
 #include "Utils.hpp"
 #include "Obstacle.hpp"
 #include "Road.hpp"
+#include "Profiler.hpp"
 #include <iostream>
-#include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/Transform.hpp>
 #include <limits>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <deque>
 #include <unordered_set>
 #include <cstdint>
@@ -19,7 +20,7 @@ Car::Car(float x, float y, float w, float h, ControlType type, float maxSpd, sf:
     : position(x, y),
       width(w), height(h), maxSpeed(maxSpd), acceleration(0.2f),
       brakePower(acceleration * 2.0f), friction(0.05f), controlType(type),
-      controls(type), color(col), textureLoaded(false), sprite(texture),
+      controls(type), color(col),
       desiredAcceleration(0.0f), lastAppliedAcceleration(0.0f),
       stoppedTimer(0.0f), reversingTimer(0.0f),
       previousYPosition(y),
@@ -30,10 +31,6 @@ Car::Car(float x, float y, float w, float h, ControlType type, float maxSpd, sf:
       stuckCheckStartY(y)
 {
     useBrain = (controlType == ControlType::AI);
-    loadTexture("assets/car.png");
-    if (!textureLoaded) {
-        // std::cerr << "Warning: Failed to load car texture (assets/car.png)." << std::endl;
-    }
 
     if (controlType != ControlType::DUMMY) {
         sensor = std::make_unique<Sensor>(*this);
@@ -49,35 +46,32 @@ Car::Car(float x, float y, float w, float h, ControlType type, float maxSpd, sf:
     }
 }
 
-// --- loadTexture ---
-void Car::loadTexture(const std::string& filename) {
-    textureLoaded = false;
-    if (!texture.loadFromFile(filename)) return;
-    texture.setSmooth(true);
-    sprite.setTexture(texture, true);
-    sf::FloatRect textureRect = sprite.getLocalBounds();
-    if (textureRect.size.x > 0 && textureRect.size.y > 0) {
-        sprite.setScale({width / textureRect.size.x, height / textureRect.size.y});
-        sprite.setOrigin({textureRect.size.x / 2.0f, textureRect.size.y / 2.0f});
-        sprite.setColor(color);
-        textureLoaded = true;
-        return;
+// --- getSharedTexture ---
+const sf::Texture* Car::getSharedTexture() {
+    static sf::Texture texture;
+    static bool textureLoaded = false;
+    static bool loadAttempted = false;
+    if (!loadAttempted) {
+        loadAttempted = true;
+        if (texture.loadFromFile("assets/car.png")) {
+            sf::Vector2u size = texture.getSize();
+            textureLoaded = size.x > 0 && size.y > 0;
+            texture.setSmooth(true);
+        }
     }
-
-    sprite.setScale({1.0f, 1.0f});
-    sprite.setOrigin({textureRect.size.x / 2.0f, textureRect.size.y / 2.0f});
-    sprite.setColor(color);
-    textureLoaded = true;
-    return;
+    return textureLoaded ? &texture : nullptr;
 }
 
 int Car::getSensorRayCount() const { return sensor ? static_cast<int>(sensor->rayCount) : 0; }
+float Car::getSensorRayLength() const { return sensor ? sensor->rayLength : 0.0f; }
 
 void Car::resetForNewGeneration(float startY, const Road& road) {
     position = { road.getLaneCenter(1), startY };
     angle = 0.0f;
     speed = 0.0f;
     damaged = false;
+    retireReason = RetireReason::NONE;
+    multiplicity = 1;
     currentFitness = 0.0f;
     previousYPosition = startY;
     previousAngle = 0.0f;
@@ -88,7 +82,96 @@ void Car::resetForNewGeneration(float startY, const Road& road) {
     stuckCheckTimer = 0.0f;
     stuckCheckStartY = startY;
     passedObstacleIDs.clear();
-    previousLaneIndex = getCurrentLaneIndex(road);
+    previousLaneIndex = getSettledLaneIndex(road);
+}
+
+
+void Car::retire(float finalFitness, RetireReason reason) {
+    damaged = true; // Excluded from updates, focus and obstacle streaming like any finished car
+    retireReason = reason;
+    speed = 0.0f;
+    currentFitness = finalFitness;
+}
+
+void Car::mergeInto(Car& leader) {
+    retire(0.0f, RetireReason::MERGED); // Placeholder until splitFrom hands over the leader's outcome
+    leader.multiplicity += multiplicity;
+    multiplicity = 0;
+}
+
+void Car::splitFrom(const Car& leader) {
+    position = leader.position;
+    angle = leader.angle;
+    speed = leader.speed;
+    damaged = leader.damaged;
+    currentFitness = leader.currentFitness;
+    previousYPosition = leader.previousYPosition;
+    previousAngle = leader.previousAngle;
+    previousLaneIndex = leader.previousLaneIndex;
+    stoppedTimer = leader.stoppedTimer;
+    reversingTimer = leader.reversingTimer;
+    stuckCheckTimer = leader.stuckCheckTimer;
+    stuckCheckStartY = leader.stuckCheckStartY;
+    desiredAcceleration = leader.desiredAcceleration;
+    lastAppliedAcceleration = leader.lastAppliedAcceleration;
+    passedObstacleIDs = leader.passedObstacleIDs;
+    retireReason = leader.retireReason;
+    multiplicity = 1;
+}
+
+float Car::getMaxTravel(float remainingSeconds, float timeStep) const {
+    const float ticks = std::ceil(std::max(0.0f, remainingSeconds) / timeStep);
+    return ticks * maxSpeed * timeStep * 60.0f; // move() scales speed per 1/60 s
+}
+
+float Car::getFitnessUpperBound(float remainingSeconds, float timeStep, float laneWidth, int maxOvertakes) const {
+    if (damaged) return currentFitness;
+    const float ticks = std::ceil(std::max(0.0f, remainingSeconds) / timeStep);
+    const float travel = getMaxTravel(remainingSeconds, timeStep);
+    // Every tick at full speed straight ahead, and every lane change and overtake the travel allows.
+    // Between two counted lane changes the car crosses both hysteresis bands; the first may be
+    // nearly complete already.
+    const float settleDistance = 2.0f * LANE_CHANGE_HYSTERESIS * laneWidth;
+    const float laneChanges = 1.0f + (settleDistance > 0.0f ? std::floor(travel / settleDistance) : 0.0f);
+    return currentFitness + travel
+           + ticks * (FITNESS_FRAME_SURVIVAL_REWARD + FITNESS_SPEED_REWARD)
+           + laneChanges * FITNESS_LANE_CHANGE_BONUS
+           + static_cast<float>(maxOvertakes) * FITNESS_OVERTAKE_BONUS;
+}
+
+float Car::getFitnessLowerBound(float remainingSeconds, float timeStep) const {
+    if (damaged) return currentFitness;
+    const float ticks = std::ceil(std::max(0.0f, remainingSeconds) / timeStep);
+    // Full reverse speed while spinning every tick, then the largest single ending penalty
+    const float worstTick = maxSpeed * (2.0f / 3.0f) * timeStep * 60.0f + FITNESS_SPINNING_PENALTY;
+    const float worstEnding = std::max({FITNESS_STOPPED_PENALTY, FITNESS_REVERSING_PENALTY, FITNESS_STUCK_PENALTY,
+                                        FITNESS_COLLISION_PENALTY + FITNESS_FAIL_OVERTAKE_PENALTY});
+    return currentFitness - ticks * worstTick - worstEnding;
+}
+
+uint64_t Car::getStateHash() const {
+    // FNV-1a over the values that differ between cars at the start of a run
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](float value) {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (bits >> (8 * i)) & 0xFFu;
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(position.x);
+    mix(position.y);
+    mix(angle);
+    mix(speed);
+    mix(maxSpeed);
+    return hash;
+}
+
+bool Car::sameState(const Car& other) const {
+    auto sameBits = [](float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; };
+    return sameBits(position.x, other.position.x) && sameBits(position.y, other.position.y) &&
+           sameBits(angle, other.angle) && sameBits(speed, other.speed) && sameBits(maxSpeed, other.maxSpeed);
 }
 
 
@@ -155,23 +238,25 @@ void Car::update(const Road& road, const std::vector<Obstacle*>& obstacles, sf::
     }
 
     // 1. Update Sensor
+    PROFILE_SCOPE_NAMED(phaseTimer, ProfilePhase::SENSORS);
     if (sensor) { sensor->update(road.borders, obstacles); }
 
     // 2. Define controls
+    PROFILE_SWITCH(phaseTimer, ProfilePhase::CONTROLS);
     updateBasedOnControls(this->controls);
 
     // 3. Move car
+    PROFILE_SWITCH(phaseTimer, ProfilePhase::MOVE);
     move(0.0f, deltaTime);
 
     // --- Lane change main logic ---
-    int currentLaneIndex = getCurrentLaneIndex(road);
-    if (previousLaneIndex == -1 && currentLaneIndex != -1) {
-        previousLaneIndex = currentLaneIndex;
-    } else if (currentLaneIndex != -1 && previousLaneIndex != -1 && currentLaneIndex != previousLaneIndex) {
-        currentFitness += FITNESS_LANE_CHANGE_BONUS;
-        previousLaneIndex = currentLaneIndex;
-    } else if (currentLaneIndex != -1) {
-        previousLaneIndex = currentLaneIndex;
+    // A change only counts once the car has settled in the new lane, so weaving on a lane line earns nothing
+    const int settledLaneIndex = getSettledLaneIndex(road);
+    if (settledLaneIndex != -1) {
+        if (previousLaneIndex != -1 && settledLaneIndex != previousLaneIndex) {
+            currentFitness += FITNESS_LANE_CHANGE_BONUS;
+        }
+        previousLaneIndex = settledLaneIndex;
     }
 
 
@@ -218,6 +303,7 @@ void Car::update(const Road& road, const std::vector<Obstacle*>& obstacles, sf::
      if (damaged && !wasAlreadyDamaged) { currentFitness -= FITNESS_STUCK_PENALTY; return; }
 
     // 9. Verify final colision
+    PROFILE_SWITCH(phaseTimer, ProfilePhase::COLLISION);
     Obstacle* hitObstacle = nullptr;
     bool collisionOccurred = checkForCollision(road.borders, obstacles, hitObstacle);
     if (collisionOccurred) {
@@ -245,6 +331,17 @@ int Car::getCurrentLaneIndex(const Road& road) const {
     return std::max(0, std::min(laneIndex, road.laneCount - 1));
 }
 
+int Car::getSettledLaneIndex(const Road& road) const {
+    const int laneIndex = getCurrentLaneIndex(road);
+    if (laneIndex == -1) {
+        return -1;
+    }
+    const float laneWidth = road.width / static_cast<float>(road.laneCount);
+    const float offset = position.x - (road.left + laneIndex * laneWidth);
+    const float margin = LANE_CHANGE_HYSTERESIS * laneWidth;
+    return (offset >= margin && offset <= laneWidth - margin) ? laneIndex : -1;
+}
+
 
 void Car::checkStuckStatus(sf::Time deltaTime) {
     if (damaged || controlType != ControlType::AI) {
@@ -393,32 +490,17 @@ bool Car::checkForCollision(const std::vector<std::pair<sf::Vector2f, sf::Vector
     return false;
 }
 
-void Car::draw(sf::RenderTarget& target, bool drawSensorFlag) {
-    sf::Color drawColorToUse = color;
+sf::Color Car::getDrawColor() const {
+    sf::Color drawColor = color;
     if (damaged) {
-        drawColorToUse.r = static_cast<uint8_t>(std::max(0, static_cast<int>(drawColorToUse.r) - 100));
-        drawColorToUse.g = static_cast<uint8_t>(std::max(0, static_cast<int>(drawColorToUse.g) - 100));
-        drawColorToUse.b = static_cast<uint8_t>(std::max(0, static_cast<int>(drawColorToUse.b) - 100));
-        drawColorToUse.a = 180;
-    }
-
-    if (textureLoaded) {
-        sprite.setColor(drawColorToUse);
-        sprite.setPosition(position);
-        sprite.setRotation(sf::degrees(angle));
-        target.draw(sprite);
-    } else {
-        sf::RectangleShape fallbackRect({width, height});
-        fallbackRect.setOrigin({width / 2.0f, height / 2.0f});
-        fallbackRect.setPosition(position);
-        fallbackRect.setRotation(sf::degrees(angle));
-        fallbackRect.setFillColor(drawColorToUse);
-        fallbackRect.setOutlineColor(sf::Color::Black);
-        fallbackRect.setOutlineThickness(1);
-        target.draw(fallbackRect);
+        drawColor.r = static_cast<uint8_t>(std::max(0, static_cast<int>(drawColor.r) - 100));
+        drawColor.g = static_cast<uint8_t>(std::max(0, static_cast<int>(drawColor.g) - 100));
+        drawColor.b = static_cast<uint8_t>(std::max(0, static_cast<int>(drawColor.b) - 100));
+        drawColor.a = 180;
     }
+    return drawColor;
+}
 
-    if (sensor && drawSensorFlag) {
-        sensor->draw(target);
-    }
-}
\ No newline at end of file
+void Car::appendSensorVertices(std::vector<sf::Vertex>& lines) const {
+    if (sensor) sensor->appendRayVertices(lines);
+}
@@ -0,0 +1,569 @@
+#include "DistributedTraining.hpp"
+#include "HeadlessWorld.hpp"
+#include "ScenarioBank.hpp"
+#include "Road.hpp"
+#include "Selection.hpp"
+#include <SFML/System/Clock.hpp>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <cstring>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+#include <chrono>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <unistd.h>
+#include <signal.h>
+#endif
+
+namespace {
+
+// --- Wire protocol: [uint32 type][uint32 payload bytes][payload], host byte order (same box) ---
+enum MessageType : uint32_t {
+    WIRE_HELLO = 1,
+    WIRE_CONFIG = 2,    // road, course, scenario bank parameters, network structure
+    WIRE_BATCH = 3,     // batch id, scenario id, genome count, genome size, genomes
+    WIRE_RESULT = 4,    // batch id, genome count, ticks simulated, fitness per genome
+    WIRE_SHUTDOWN = 5
+};
+
+constexpr int CONNECT_TIMEOUT_MS = 10000;
+constexpr int SHUTDOWN_TIMEOUT_MS = 2000;        // Workers still running after this are killed
+constexpr uint32_t MAX_PAYLOAD_BYTES = 64u << 20; // Far above any batch; guards against garbage headers
+
+class MessageWriter {
+public:
+    template <typename T>
+    void put(const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+    void putFloats(const std::vector<float>& values) {
+        const char* bytes = reinterpret_cast<const char*>(values.data());
+        data.insert(data.end(), bytes, bytes + values.size() * sizeof(float));
+    }
+    std::vector<char> data;
+};
+
+class MessageReader {
+public:
+    explicit MessageReader(const std::vector<char>& payload) : data(payload) {}
+    template <typename T>
+    bool get(T& value) {
+        if (offset + sizeof(T) > data.size()) return false;
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+    const float* floats(size_t count) {
+        if (offset + count * sizeof(float) > data.size()) return nullptr;
+        const float* values = reinterpret_cast<const float*>(data.data() + offset);
+        offset += count * sizeof(float);
+        return values;
+    }
+    size_t remaining() const { return data.size() - offset; }
+private:
+    const std::vector<char>& data;
+    size_t offset = 0;
+};
+
+#ifndef _WIN32
+bool writeAll(int fd, const char* bytes, size_t size) {
+    while (size > 0) {
+#ifdef MSG_NOSIGNAL
+        const ssize_t written = ::send(fd, bytes, size, MSG_NOSIGNAL);
+#else
+        const ssize_t written = ::send(fd, bytes, size, 0);
+#endif
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool readAll(int fd, char* bytes, size_t size) {
+    while (size > 0) {
+        const ssize_t received = ::recv(fd, bytes, size, 0);
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) return false;
+        bytes += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+bool sendMessage(int fd, uint32_t type, const std::vector<char>& payload) {
+    const uint32_t header[2] = {type, static_cast<uint32_t>(payload.size())};
+    return writeAll(fd, reinterpret_cast<const char*>(header), sizeof(header)) &&
+           writeAll(fd, payload.data(), payload.size());
+}
+
+bool receiveMessage(int fd, uint32_t& type, std::vector<char>& payload) {
+    uint32_t header[2];
+    if (!readAll(fd, reinterpret_cast<char*>(header), sizeof(header))) return false;
+    type = header[0];
+    if (header[1] > MAX_PAYLOAD_BYTES) return false;
+    payload.resize(header[1]);
+    return readAll(fd, payload.data(), payload.size());
+}
+
+bool fitsAddress(const std::string& socketPath) {
+    return !socketPath.empty() && socketPath.size() < sizeof(sockaddr_un{}.sun_path);
+}
+
+sockaddr_un makeAddress(const std::string& socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+}
+#endif
+
+} // namespace
+
+TrainingCoordinator::TrainingCoordinator(const DistributedSettings& distributedSettings, const std::vector<int>& structure)
+    : settings(distributedSettings), networkStructure(structure),
+      bestBrainOfGeneration(std::make_unique<NeuralNetwork>(structure)),
+      currentMutationRate(distributedSettings.initialMutationRate)
+{
+    if (settings.brainFilename.empty()) return;
+    if (bestBrainOfGeneration->loadFromFile(settings.brainFilename) &&
+        bestBrainOfGeneration->getGenomeSize() == NeuralNetwork(structure).getGenomeSize()) {
+        std::cout << "Coordinator: continuing from " << settings.brainFilename << std::endl;
+    } else {
+        bestBrainOfGeneration = std::make_unique<NeuralNetwork>(structure);
+    }
+}
+
+TrainingCoordinator::TrainingCoordinator(const DistributedSettings& distributedSettings, const NeuralNetwork& initialBrain)
+    : settings(distributedSettings),
+      bestBrainOfGeneration(std::make_unique<NeuralNetwork>(initialBrain)),
+      currentMutationRate(distributedSettings.initialMutationRate)
+{
+    networkStructure.push_back(static_cast<int>(initialBrain.levels.front().inputs.size()));
+    for (const Level& level : initialBrain.levels) {
+        networkStructure.push_back(static_cast<int>(level.outputs.size()));
+    }
+}
+
+TrainingCoordinator::~TrainingCoordinator() {
+    stopWorkers();
+}
+
+double TrainingCoordinator::getEvaluationsPerSecond() const {
+    return evaluationSeconds > 0.0 ? static_cast<double>(evaluationsDone) / evaluationSeconds : 0.0;
+}
+
+double TrainingCoordinator::getTicksPerSecond() const {
+    return evaluationSeconds > 0.0 ? static_cast<double>(ticksSimulated) / evaluationSeconds : 0.0;
+}
+
+#ifdef _WIN32
+
+bool TrainingCoordinator::run() {
+    std::cerr << "Distributed training needs Unix-domain sockets and is not available on this platform." << std::endl;
+    return false;
+}
+bool TrainingCoordinator::startWorkers() { return false; }
+bool TrainingCoordinator::listenOnSocket() { return false; }
+void TrainingCoordinator::closeListenSocket() {}
+void TrainingCoordinator::stopWorkers() {}
+bool TrainingCoordinator::evaluateGeneration(const std::vector<NeuralNetwork>&, uint32_t, std::vector<float>&) { return false; }
+bool TrainingCoordinator::sendBatch(WorkerConnection&, const std::vector<NeuralNetwork>&, size_t, size_t, uint32_t) { return false; }
+int runTrainingWorker(const std::string&) { return EXIT_FAILURE; }
+
+#else
+
+bool TrainingCoordinator::run() {
+    if (!startWorkers()) {
+        stopWorkers();
+        return false;
+    }
+
+    const int subsetSize = std::max(1, std::min(settings.scenarioSubsetSize, settings.scenarioCount));
+    std::vector<NeuralNetwork> population;
+    std::vector<float> fitness;
+
+    for (int generation = 1; generation <= settings.generations; ++generation) {
+        // Elite plus mutated clones, as in the windowed trainer
+        population.assign(static_cast<size_t>(std::max(1, settings.populationSize)), *bestBrainOfGeneration);
+        for (size_t i = 1; i < population.size(); ++i) {
+            NeuralNetwork::mutate(population[i], currentMutationRate);
+        }
+
+        const uint32_t scenarioId = static_cast<uint32_t>((generation - 1) % subsetSize);
+        sf::Clock generationClock;
+        const long long ticksBefore = ticksSimulated;
+        if (!evaluateGeneration(population, scenarioId, fitness)) {
+            std::cerr << "Coordinator: lost a worker during generation " << generation << "; stopping." << std::endl;
+            stopWorkers();
+            return false;
+        }
+        const float seconds = generationClock.getElapsedTime().asSeconds();
+        evaluationSeconds += seconds;
+        evaluationsDone += static_cast<long long>(population.size());
+
+        const size_t bestIndex = static_cast<size_t>(std::distance(fitness.begin(), std::max_element(fitness.begin(), fitness.end())));
+        const float averageFitness = std::accumulate(fitness.begin(), fitness.end(), 0.0f) / static_cast<float>(fitness.size());
+        *bestBrainOfGeneration = population[bestIndex];
+
+        averageFitnessHistory.push(averageFitness);
+        bestFitnessHistory.push(fitness[bestIndex]);
+
+        currentMutationRate = scheduledMutationRate(settings.initialMutationRate, settings.minMutationRate,
+                                                    settings.mutationDecayFactor, generation);
+
+        std::cout << "Gen " << generation << " (scenario " << scenarioId << "): best " << fitness[bestIndex]
+                  << ", avg " << averageFitness << ", " << std::fixed << std::setprecision(1)
+                  << (seconds > 0.0f ? population.size() / seconds : 0.0f) << " genomes/s, "
+                  << (seconds > 0.0f ? (ticksSimulated - ticksBefore) / seconds : 0.0f) << " ticks/s"
+                  << std::defaultfloat << std::setprecision(6) << std::endl;
+    }
+
+    if (settings.brainFilename.empty()) {
+        // Nothing to persist (throughput runs)
+    } else if (bestBrainOfGeneration->saveToFile(settings.brainFilename)) {
+        std::cout << "Coordinator: saved best brain to " << settings.brainFilename << std::endl;
+    } else {
+        std::cerr << "Coordinator: could not save best brain to " << settings.brainFilename << std::endl;
+    }
+    stopWorkers();
+    return true;
+}
+
+bool TrainingCoordinator::listenOnSocket() {
+    activeSocketPath = settings.socketPath;
+    if (activeSocketPath.empty()) {
+        // A private directory (mode 0700) per run: nobody else can pre-create or replace the socket
+        const char* tmp = std::getenv("TMPDIR");
+        std::string pattern = std::string(tmp && *tmp ? tmp : "/tmp") + "/selfdriving-XXXXXX";
+        if (!::mkdtemp(&pattern[0])) {
+            std::cerr << "Coordinator: could not create a socket directory: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        socketDirectory = pattern;
+        activeSocketPath = socketDirectory + "/coordinator.sock";
+    }
+    if (!fitsAddress(activeSocketPath)) {
+        std::cerr << "Coordinator: socket path too long: " << activeSocketPath << std::endl;
+        activeSocketPath.clear();
+        return false;
+    }
+
+    // An explicit path that already exists is not ours to remove, so bind simply fails on it
+    listenSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    const sockaddr_un address = makeAddress(activeSocketPath);
+    if (listenSocket < 0 || ::bind(listenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << "Coordinator: could not bind " << activeSocketPath << ": " << std::strerror(errno) << std::endl;
+        activeSocketPath.clear();
+        return false;
+    }
+    if (::listen(listenSocket, settings.workerCount) != 0) {
+        std::cerr << "Coordinator: could not listen on " << activeSocketPath << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void TrainingCoordinator::closeListenSocket() {
+    if (listenSocket >= 0) {
+        ::close(listenSocket);
+        listenSocket = -1;
+    }
+    if (!activeSocketPath.empty()) {
+        ::unlink(activeSocketPath.c_str());
+        activeSocketPath.clear();
+    }
+    if (!socketDirectory.empty()) {
+        ::rmdir(socketDirectory.c_str());
+        socketDirectory.clear();
+    }
+}
+
+bool TrainingCoordinator::startWorkers() {
+    ::signal(SIGPIPE, SIG_IGN); // A dead worker must surface as a write error, not kill us
+
+    if (!listenOnSocket()) return false;
+
+    for (int i = 0; i < settings.workerCount; ++i) {
+        const pid_t pid = ::fork();
+        if (pid == 0) {
+            ::execl(settings.executablePath.c_str(), settings.executablePath.c_str(),
+                    "--worker", activeSocketPath.c_str(), static_cast<char*>(nullptr));
+            _exit(127);
+        }
+        if (pid < 0) {
+            std::cerr << "Coordinator: fork failed: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        WorkerConnection worker;
+        worker.pid = pid;
+        workers.push_back(worker);
+    }
+
+    // Workers connect in any order; sockets are matched to slots, not to pids
+    MessageWriter config;
+    config.put(settings.roadCenterX);
+    config.put(settings.roadWidth);
+    config.put(static_cast<int32_t>(settings.laneCount));
+    config.put(settings.course);
+    config.put(static_cast<int32_t>(settings.scenarioCount));
+    config.put(static_cast<int32_t>(settings.scenarioChunkCount));
+    config.put(settings.scenarioSeed);
+    config.put(settings.maxSecondsPerRun);
+    config.put(static_cast<uint32_t>(networkStructure.size()));
+    for (int neurons : networkStructure) config.put(static_cast<int32_t>(neurons));
+
+    for (WorkerConnection& worker : workers) {
+        pollfd waitForWorker{listenSocket, POLLIN, 0};
+        if (::poll(&waitForWorker, 1, CONNECT_TIMEOUT_MS) <= 0) {
+            std::cerr << "Coordinator: timed out waiting for workers to connect." << std::endl;
+            return false;
+        }
+        worker.socket = ::accept(listenSocket, nullptr, nullptr);
+        uint32_t type = 0;
+        std::vector<char> payload;
+        if (worker.socket < 0 || !receiveMessage(worker.socket, type, payload) || type != WIRE_HELLO ||
+            !sendMessage(worker.socket, WIRE_CONFIG, config.data)) {
+            std::cerr << "Coordinator: worker handshake failed." << std::endl;
+            return false;
+        }
+    }
+    std::cout << "Coordinator: " << workers.size() << " workers connected on " << activeSocketPath << std::endl;
+    return true;
+}
+
+void TrainingCoordinator::stopWorkers() {
+    // Closing the listener first makes a worker that has not been accepted yet see its
+    // connection reset instead of waiting forever for its configuration
+    closeListenSocket();
+    for (WorkerConnection& worker : workers) {
+        if (worker.socket >= 0) {
+            sendMessage(worker.socket, WIRE_SHUTDOWN, {});
+            ::close(worker.socket);
+        }
+    }
+
+    // A worker stuck anywhere else (e.g. still being exec'd) is killed after a grace period
+    sf::Clock shutdownClock;
+    size_t running = workers.size();
+    while (running > 0) {
+        running = 0;
+        for (WorkerConnection& worker : workers) {
+            if (worker.pid <= 0) continue;
+            if (::waitpid(worker.pid, nullptr, WNOHANG) == 0) {
+                running++;
+            } else {
+                worker.pid = -1;
+            }
+        }
+        if (running == 0) break;
+        if (shutdownClock.getElapsedTime().asMilliseconds() >= SHUTDOWN_TIMEOUT_MS) {
+            std::cerr << "Coordinator: killing " << running << " workers that did not shut down." << std::endl;
+            for (WorkerConnection& worker : workers) {
+                if (worker.pid <= 0) continue;
+                ::kill(worker.pid, SIGKILL);
+                ::waitpid(worker.pid, nullptr, 0);
+                worker.pid = -1;
+            }
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    workers.clear();
+}
+
+bool TrainingCoordinator::sendBatch(WorkerConnection& worker, const std::vector<NeuralNetwork>& population,
+                                    size_t first, size_t count, uint32_t scenarioId) {
+    MessageWriter batch;
+    batch.put(++worker.batchId);
+    batch.put(scenarioId);
+    batch.put(static_cast<uint32_t>(count));
+    batch.put(static_cast<uint32_t>(population[first].getGenomeSize()));
+    for (size_t i = first; i < first + count; ++i) {
+        batch.putFloats(population[i].toGenome());
+    }
+    worker.first = first;
+    worker.count = count;
+    worker.busy = true;
+    return sendMessage(worker.socket, WIRE_BATCH, batch.data);
+}
+
+bool TrainingCoordinator::evaluateGeneration(const std::vector<NeuralNetwork>& population, uint32_t scenarioId,
+                                             std::vector<float>& fitness) {
+    fitness.assign(population.size(), -std::numeric_limits<float>::infinity());
+    const size_t batchSize = static_cast<size_t>(std::max(1, settings.genomesPerBatch));
+    size_t nextGenome = 0;
+    size_t pendingBatches = 0;
+
+    auto dispatch = [&](WorkerConnection& worker) {
+        if (nextGenome >= population.size()) return true;
+        const size_t count = std::min(batchSize, population.size() - nextGenome);
+        if (!sendBatch(worker, population, nextGenome, count, scenarioId)) return false;
+        nextGenome += count;
+        ++pendingBatches;
+        return true;
+    };
+
+    for (WorkerConnection& worker : workers) {
+        if (!dispatch(worker)) return false;
+    }
+
+    std::vector<pollfd> pollSet(workers.size());
+    std::vector<char> payload;
+    while (pendingBatches > 0) {
+        for (size_t i = 0; i < workers.size(); ++i) {
+            pollSet[i] = {workers[i].socket, static_cast<short>(workers[i].busy ? POLLIN : 0), 0};
+        }
+        if (::poll(pollSet.data(), pollSet.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+
+        for (size_t i = 0; i < workers.size(); ++i) {
+            if (!(pollSet[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            WorkerConnection& worker = workers[i];
+
+            uint32_t type = 0, batchId = 0, count = 0;
+            uint64_t ticks = 0;
+            if (!receiveMessage(worker.socket, type, payload) || type != WIRE_RESULT) return false;
+            MessageReader result(payload);
+            const float* values = nullptr;
+            if (!result.get(batchId) || !result.get(count) || !result.get(ticks) ||
+                batchId != worker.batchId || count != worker.count || !(values = result.floats(count))) {
+                return false;
+            }
+            std::copy(values, values + count, fitness.begin() + worker.first);
+            ticksSimulated += static_cast<long long>(ticks);
+            worker.busy = false;
+            --pendingBatches;
+            if (!dispatch(worker)) return false;
+        }
+    }
+    return true;
+}
+
+void TrainingCoordinator::runScalingReport(DistributedSettings settings, const std::vector<int>& networkStructure, int maxWorkers) {
+    std::vector<int> workerCounts;
+    for (int count = 1; count < maxWorkers; count *= 2) workerCounts.push_back(count);
+    workerCounts.push_back(std::max(1, maxWorkers));
+
+    const NeuralNetwork initialBrain(networkStructure);
+    settings.brainFilename.clear(); // Keep the real brain file untouched
+
+    struct Row { int workers; double genomesPerSecond; double ticksPerSecond; };
+    std::vector<Row> rows;
+    for (int count : workerCounts) {
+        settings.workerCount = count;
+        TrainingCoordinator coordinator(settings, initialBrain);
+        if (!coordinator.run()) break;
+        rows.push_back({count, coordinator.getEvaluationsPerSecond(), coordinator.getTicksPerSecond()});
+    }
+    if (rows.empty()) return;
+
+    std::cout << "\n--- Distributed throughput (" << settings.populationSize << " genomes x "
+              << settings.generations << " generations, " << std::thread::hardware_concurrency()
+              << " hardware threads) ---" << std::endl;
+    std::cout << "workers  genomes/s     ticks/s  speedup (ticks/s)" << std::endl;
+    for (const Row& row : rows) {
+        std::cout << std::setw(7) << row.workers << "  " << std::fixed << std::setprecision(1)
+                  << std::setw(9) << row.genomesPerSecond << "  " << std::setw(10) << row.ticksPerSecond << "  "
+                  << std::setprecision(2) << std::setw(6)
+                  << (rows.front().ticksPerSecond > 0.0 ? row.ticksPerSecond / rows.front().ticksPerSecond : 0.0)
+                  << "x" << std::endl;
+    }
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
+
+int runTrainingWorker(const std::string& socketPath) {
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    const sockaddr_un address = makeAddress(socketPath);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << "Worker: could not connect to " << socketPath << ": " << std::strerror(errno) << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    uint32_t type = 0;
+    std::vector<char> payload;
+    if (!sendMessage(fd, WIRE_HELLO, {}) || !receiveMessage(fd, type, payload) || type != WIRE_CONFIG) {
+        std::cerr << "Worker: handshake failed." << std::endl;
+        ::close(fd);
+        return EXIT_FAILURE;
+    }
+
+    float roadCenterX = 0.0f, roadWidth = 0.0f, maxSeconds = 0.0f;
+    int32_t laneCount = 0, scenarioCount = 0, scenarioChunkCount = 0;
+    uint64_t scenarioSeed = 0;
+    uint32_t structureSize = 0;
+    CourseLayout course{};
+    MessageReader config(payload);
+    bool configValid = config.get(roadCenterX) && config.get(roadWidth) && config.get(laneCount) &&
+                       config.get(course) && config.get(scenarioCount) && config.get(scenarioChunkCount) &&
+                       config.get(scenarioSeed) && config.get(maxSeconds) && config.get(structureSize);
+    std::vector<int> structure(configValid ? structureSize : 0);
+    for (int& neurons : structure) {
+        int32_t value = 0;
+        configValid = configValid && config.get(value);
+        neurons = value;
+    }
+    if (!configValid) {
+        std::cerr << "Worker: malformed configuration." << std::endl;
+        ::close(fd);
+        return EXIT_FAILURE;
+    }
+
+    // The bank is deterministic in its seed, so every worker rebuilds the same scenarios locally
+    Road road(roadCenterX, roadWidth, laneCount);
+    ScenarioBank bank(road.left, road.width, road.laneCount, course);
+    bank.generate(scenarioCount, scenarioChunkCount, scenarioSeed);
+    HeadlessWorld world(road, course);
+    NeuralNetwork brain(structure);
+
+    while (receiveMessage(fd, type, payload) && type == WIRE_BATCH) {
+        MessageReader batch(payload);
+        uint32_t batchId = 0, scenarioId = 0, count = 0, genomeSize = 0;
+        if (!batch.get(batchId) || !batch.get(scenarioId) || !batch.get(count) || !batch.get(genomeSize) ||
+            scenarioId >= bank.size()) {
+            break;
+        }
+        // Checked before anything is sized from the header: every genome must be in the payload
+        if (genomeSize != brain.getGenomeSize() ||
+            static_cast<uint64_t>(count) * genomeSize * sizeof(float) != batch.remaining()) {
+            std::cerr << "Worker: malformed batch " << batchId << "." << std::endl;
+            break;
+        }
+
+        const long long ticksBefore = world.getTicksSimulated();
+        std::vector<float> fitness(count, -std::numeric_limits<float>::infinity());
+        for (uint32_t i = 0; i < count; ++i) {
+            const float* genome = batch.floats(genomeSize);
+            if (genome && brain.fromGenome(genome, genomeSize)) {
+                fitness[i] = world.evaluate(brain, bank.get(scenarioId), maxSeconds);
+            }
+        }
+
+        MessageWriter result;
+        result.put(batchId);
+        result.put(count);
+        result.put(static_cast<uint64_t>(world.getTicksSimulated() - ticksBefore));
+        result.putFloats(fitness);
+        if (!sendMessage(fd, WIRE_RESULT, result.data)) break;
+    }
+
+    ::close(fd);
+    return EXIT_SUCCESS;
+}
+
+#endif
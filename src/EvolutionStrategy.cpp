@@ -0,0 +1,244 @@
+#include "EvolutionStrategy.hpp"
+#include "DistributedTraining.hpp"
+#include "IslandModel.hpp"
+#include "ScenarioBank.hpp"
+#include "Road.hpp"
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace {
+uint64_t mixBits(uint64_t z) {
+    // splitmix64 finaliser
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+}
+
+EvolutionStrategy::EvolutionStrategy(const Road& road, const CourseLayout& course, const ScenarioBank& scenarioBank,
+                                     const NeuralNetwork& initialMean, const EsSettings& esSettings)
+    : bank(scenarioBank), settings(esSettings), pool(esSettings.workerCount), mean(initialMean.toGenome())
+{
+    settings.pairsPerIteration = std::max(1, settings.pairsPerIteration);
+    worlds.reserve(pool.getWorkerCount());
+    workerNetworks.reserve(pool.getWorkerCount());
+    for (size_t i = 0; i < pool.getWorkerCount(); ++i) {
+        worlds.push_back(std::make_unique<HeadlessWorld>(road, course));
+        workerNetworks.push_back(initialMean);
+    }
+    bestGenome.emplace(initialMean);
+}
+
+float EvolutionStrategy::noise(uint64_t seed, uint64_t iterationIndex, uint64_t candidate, uint64_t parameter) {
+    uint64_t key = mixBits(seed + 0x9E3779B97F4A7C15ULL * (iterationIndex + 1));
+    key = mixBits(key ^ (candidate * 0xD1B54A32D192ED03ULL));
+    key = mixBits(key ^ (parameter * 0x8CB92BA72F3D8DD7ULL));
+    // Box-Muller from the two 32-bit halves
+    const float u1 = (static_cast<float>(key >> 40) + 1.0f) / 16777217.0f; // (0, 1]
+    const float u2 = static_cast<float>((key >> 8) & 0xFFFFFF) / 16777216.0f;
+    return std::sqrt(-2.0f * std::log(u1)) * std::cos(6.2831853f * u2);
+}
+
+float EvolutionStrategy::step() {
+    const size_t subset = std::min(bank.size(), static_cast<size_t>(std::max(1, settings.scenarioSubsetSize)));
+    if (subset == 0) return bestFitness;
+    const Scenario& scenario = bank.get(static_cast<uint32_t>(iteration % subset));
+    const size_t pairCount = static_cast<size_t>(settings.pairsPerIteration);
+    const size_t parameterCount = mean.size();
+    const float sigma = settings.noiseStdDev;
+
+    // Candidate 2k is mean + sigma * eps_k, candidate 2k+1 is mean - sigma * eps_k
+    std::vector<float> fitness(pairCount * 2, -std::numeric_limits<float>::infinity());
+    pool.run(fitness.size(), [&](size_t taskIndex, size_t workerIndex) {
+        const uint64_t pair = taskIndex / 2;
+        const float sign = (taskIndex % 2 == 0) ? 1.0f : -1.0f;
+        std::vector<float> genome(parameterCount);
+        for (size_t j = 0; j < parameterCount; ++j) {
+            genome[j] = mean[j] + sign * sigma * noise(settings.noiseSeed, iteration, pair, j);
+        }
+        NeuralNetwork& network = workerNetworks[workerIndex];
+        if (!network.fromGenome(genome)) return;
+        try {
+            fitness[taskIndex] = worlds[workerIndex]->evaluate(network, scenario, settings.maxSecondsPerRun);
+        } catch (const std::exception& e) {
+            std::cerr << "ES: error evaluating candidate " << taskIndex << ": " << e.what() << std::endl;
+        }
+    });
+    evaluations += static_cast<long long>(fitness.size());
+
+    // Centred ranks in [-0.5, 0.5]: insensitive to the scale and outliers of the fitness terms
+    std::vector<size_t> order(fitness.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return fitness[a] < fitness[b]; });
+    std::vector<float> utility(fitness.size());
+    for (size_t rank = 0; rank < order.size(); ++rank) {
+        utility[order[rank]] = order.size() > 1 ? static_cast<float>(rank) / static_cast<float>(order.size() - 1) - 0.5f : 0.0f;
+    }
+
+    // This iteration's scenario may simply be an easy one, so its best candidate is re-scored on
+    // the common set (the first 'subset' scenarios) before it can become the overall best
+    const size_t best = order.back();
+    std::vector<float> bestGenomeValues(parameterCount);
+    const float bestSign = (best % 2 == 0) ? 1.0f : -1.0f;
+    for (size_t j = 0; j < parameterCount; ++j) {
+        bestGenomeValues[j] = mean[j] + bestSign * sigma * noise(settings.noiseSeed, iteration, best / 2, j);
+    }
+    std::vector<float> commonFitness(subset, -std::numeric_limits<float>::infinity());
+    pool.run(subset, [&](size_t scenarioIndex, size_t workerIndex) {
+        NeuralNetwork& network = workerNetworks[workerIndex];
+        if (!network.fromGenome(bestGenomeValues)) return;
+        try {
+            commonFitness[scenarioIndex] = worlds[workerIndex]->evaluate(
+                network, bank.get(static_cast<uint32_t>(scenarioIndex)), settings.maxSecondsPerRun);
+        } catch (const std::exception& e) {
+            std::cerr << "ES: error re-scoring candidate " << best << ": " << e.what() << std::endl;
+        }
+    });
+    evaluations += static_cast<long long>(subset);
+    const float commonSetMean = std::accumulate(commonFitness.begin(), commonFitness.end(), 0.0f) / static_cast<float>(subset);
+    if (commonSetMean > bestFitness) {
+        bestGenome->fromGenome(bestGenomeValues);
+        bestFitness = commonSetMean;
+    }
+
+    // Gradient estimate: sum over pairs of (u+ - u-) * eps / (2 * pairs * sigma)
+    std::vector<float> gradient(parameterCount, 0.0f);
+    for (size_t pair = 0; pair < pairCount; ++pair) {
+        const float weight = utility[2 * pair] - utility[2 * pair + 1];
+        if (weight == 0.0f) continue;
+        for (size_t j = 0; j < parameterCount; ++j) {
+            gradient[j] += weight * noise(settings.noiseSeed, iteration, pair, j);
+        }
+    }
+    const float scale = settings.learningRate / (2.0f * static_cast<float>(pairCount) * sigma);
+    for (size_t j = 0; j < parameterCount; ++j) {
+        mean[j] += scale * gradient[j] - settings.learningRate * settings.weightDecay * mean[j];
+    }
+
+    ++iteration;
+    return fitness[best];
+}
+
+long long EvolutionStrategy::getTicksSimulated() const {
+    long long total = 0;
+    for (const auto& world : worlds) total += world->getTicksSimulated();
+    return total;
+}
+
+NeuralNetwork EvolutionStrategy::getMean() const {
+    NeuralNetwork network = *bestGenome;
+    network.fromGenome(mean);
+    return network;
+}
+
+bool EvolutionStrategy::runTraining(const DistributedSettings& settings, const std::vector<int>& networkStructure,
+                                    int iterations) {
+    Road road(settings.roadCenterX, settings.roadWidth, settings.laneCount);
+    ScenarioBank bank(road.left, road.width, road.laneCount, settings.course);
+    bank.generate(settings.scenarioCount, settings.scenarioChunkCount, settings.scenarioSeed);
+
+    NeuralNetwork initialBrain(networkStructure);
+    if (!settings.brainFilename.empty() && initialBrain.loadFromFile(settings.brainFilename)) {
+        std::cout << "ES: starting from " << settings.brainFilename << std::endl;
+    }
+
+    EsSettings esSettings;
+    esSettings.maxSecondsPerRun = settings.maxSecondsPerRun;
+    esSettings.scenarioSubsetSize = settings.scenarioSubsetSize;
+    esSettings.workerCount = static_cast<size_t>(std::max(1, settings.workerCount));
+    EvolutionStrategy es(road, settings.course, bank, initialBrain, esSettings);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        const float iterationBest = es.step();
+        if (i % 10 == 0 || i + 1 == iterations) {
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "ES iteration " << es.getIteration() << ": best " << iterationBest
+                      << " (overall " << es.getBestFitness() << "), " << es.getEvaluations() << " evaluations, "
+                      << seconds << "s" << std::endl;
+        }
+    }
+
+    if (settings.brainFilename.empty()) return true;
+    if (!es.getBestGenome().saveToFile(settings.brainFilename)) {
+        std::cerr << "ES: could not save " << settings.brainFilename << std::endl;
+        return false;
+    }
+    std::cout << "ES: saved best candidate to " << settings.brainFilename << std::endl;
+    return true;
+}
+
+void EvolutionStrategy::runComparison(const DistributedSettings& settings, const std::vector<int>& networkStructure,
+                                      float targetFitness, float timeLimitSeconds) {
+    Road road(settings.roadCenterX, settings.roadWidth, settings.laneCount);
+    ScenarioBank bank(road.left, road.width, road.laneCount, settings.course);
+    bank.generate(settings.scenarioCount, settings.scenarioChunkCount, settings.scenarioSeed);
+    const NeuralNetwork initialBrain(networkStructure);
+    using Clock = std::chrono::steady_clock;
+
+    EsSettings esSettings;
+    esSettings.maxSecondsPerRun = settings.maxSecondsPerRun;
+    esSettings.scenarioSubsetSize = settings.scenarioSubsetSize;
+    esSettings.workerCount = 1; // The GA island is one thread; compare the algorithms, not the core count
+
+    // Both optimisers are judged on the mean fitness over these first scenarios, which each of
+    // them re-scores its best candidate of every generation or iteration on
+    const size_t commonSetSize = std::min(bank.size(), static_cast<size_t>(std::max(1, settings.scenarioSubsetSize)));
+
+    struct Row { const char* name; bool reached; double seconds; int generations; long long evaluations; float best; };
+    std::vector<Row> rows;
+
+    // GA: a single island with as many genomes as the ES samples per iteration; each row picks the
+    // selection scheme (elite + mutated clones, or multi-parent breeding with crossover)
+    auto runGa = [&](const char* name, const SelectionSettings& selection) {
+        IslandSettings gaSettings;
+        gaSettings.islandCount = 1;
+        gaSettings.populationPerIsland = 2 * esSettings.pairsPerIteration;
+        gaSettings.minMutationRate = gaSettings.maxMutationRate = settings.initialMutationRate;
+        gaSettings.maxSecondsPerRun = settings.maxSecondsPerRun;
+        gaSettings.scenarioSubsetSize = settings.scenarioSubsetSize;
+        gaSettings.selection = selection;
+        const auto start = Clock::now();
+        IslandModel ga(road, settings.course, bank, initialBrain, gaSettings);
+        double seconds = 0.0;
+        while (ga.getGlobalBestFitness() < targetFitness && seconds < timeLimitSeconds) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        // Each generation also re-scores its best genome on the common set
+        const int generations = ga.getIslandGeneration(0);
+        const long long evaluationsPerGeneration = gaSettings.populationPerIsland + static_cast<long long>(commonSetSize);
+        rows.push_back({name, ga.getGlobalBestFitness() >= targetFitness, seconds, generations,
+                        generations * evaluationsPerGeneration, ga.getGlobalBestFitness()});
+    };
+    runGa("GA", SelectionSettings{});
+    runGa("GA+unif", multiParentSelection(CrossoverMode::UNIFORM));
+    runGa("GA+layer", multiParentSelection(CrossoverMode::LAYER_WISE));
+
+    {
+        const auto start = Clock::now();
+        EvolutionStrategy es(road, settings.course, bank, initialBrain, esSettings);
+        double seconds = 0.0;
+        while (es.getBestFitness() < targetFitness && seconds < timeLimitSeconds) {
+            es.step();
+            seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        rows.push_back({"ES", es.getBestFitness() >= targetFitness, seconds, es.getIteration(), es.getEvaluations(), es.getBestFitness()});
+    }
+
+    std::cout << "\n--- Time to fitness " << targetFitness << " (limit " << timeLimitSeconds << "s, "
+              << 2 * esSettings.pairsPerIteration << " evaluations per generation) ---" << std::endl;
+    std::cout << "optimiser  reached  seconds  generations  evaluations      best" << std::endl;
+    for (const Row& row : rows) {
+        std::cout << std::setw(9) << row.name << "  " << std::setw(7) << (row.reached ? "yes" : "no") << "  "
+                  << std::fixed << std::setprecision(1) << std::setw(7) << row.seconds << "  "
+                  << std::setw(11) << row.generations << "  " << std::setw(11) << row.evaluations << "  "
+                  << std::setw(8) << row.best << std::endl;
+    }
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
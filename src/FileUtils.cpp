@@ -0,0 +1,53 @@
+#include "FileUtils.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+#include <iostream>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+bool writeFileAtomic(const std::string& filename, const std::string& contents) {
+    const std::filesystem::path path(filename);
+    if (path.has_parent_path() && !std::filesystem::exists(path.parent_path())) {
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    const std::string tempFilename = filename + ".tmp";
+    std::FILE* file = std::fopen(tempFilename.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Could not open " << tempFilename << " for writing." << std::endl;
+        return false;
+    }
+    bool ok = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+    ok = (std::fflush(file) == 0) && ok;
+#ifndef _WIN32
+    ok = (::fsync(::fileno(file)) == 0) && ok;
+#endif
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::cerr << "Error: Failed writing " << tempFilename << std::endl;
+        std::remove(tempFilename.c_str());
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempFilename, filename, error);
+    if (error) {
+        std::cerr << "Error: Could not replace " << filename << ": " << error.message() << std::endl;
+        std::remove(tempFilename.c_str());
+        return false;
+    }
+#ifndef _WIN32
+    // The rename itself is only durable once the directory entry is on disk
+    const std::string directory = path.has_parent_path() ? path.parent_path().string() : ".";
+    const int directoryFd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (directoryFd >= 0) {
+        ::fsync(directoryFd);
+        ::close(directoryFd);
+    }
+#endif
+    return true;
+}
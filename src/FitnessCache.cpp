@@ -0,0 +1,36 @@
+#include "FitnessCache.hpp"
+
+FitnessCache::FitnessCache(size_t maxEntries)
+    : capacity(maxEntries)
+{
+    entries.reserve(capacity);
+}
+
+std::optional<float> FitnessCache::find(uint64_t genomeHash, uint64_t courseSeed) {
+    auto it = entries.find({genomeHash, courseSeed});
+    if (it == entries.end()) {
+        ++misses;
+        return std::nullopt;
+    }
+    ++hits;
+    return it->second;
+}
+
+void FitnessCache::insert(uint64_t genomeHash, uint64_t courseSeed, float fitness) {
+    const Key key{genomeHash, courseSeed};
+    auto inserted = entries.emplace(key, fitness);
+    if (!inserted.second) {
+        inserted.first->second = fitness;
+        return;
+    }
+    insertionOrder.push_back(key);
+    while (entries.size() > capacity && !insertionOrder.empty()) {
+        entries.erase(insertionOrder.front());
+        insertionOrder.pop_front();
+    }
+}
+
+void FitnessCache::clear() {
+    entries.clear();
+    insertionOrder.clear();
+}
@@ -0,0 +1,260 @@
+#include "FrameCapture.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+FrameCapture::FrameCapture(size_t poolSize)
+    : poolSize(std::max<size_t>(1, poolSize))
+{
+}
+
+FrameCapture::~FrameCapture() {
+    stop();
+}
+
+bool FrameCapture::start(const std::filesystem::path& directory, Format format, sf::Vector2u windowSize, unsigned framesPerSecond) {
+    stop();
+    const sf::Vector2u frameSize(windowSize.x & ~1u, windowSize.y & ~1u);
+    if (frameSize.x == 0 || frameSize.y == 0) {
+        std::cerr << "Cannot record: window is too small." << std::endl;
+        return false;
+    }
+    if (!readbackTexture.resize(windowSize)) {
+        std::cerr << "Cannot record: failed to create a " << windowSize.x << "x" << windowSize.y << " readback texture." << std::endl;
+        return false;
+    }
+
+    char stamp[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    const std::string extension = format == Format::Y4M ? ".y4m" : "";
+    std::filesystem::path path = directory / (std::string("capture-") + stamp + extension);
+    for (int suffix = 2; std::filesystem::exists(path); ++suffix) { // Two recordings within one second
+        path = directory / (std::string("capture-") + stamp + "-" + std::to_string(suffix) + extension);
+    }
+    if (format == Format::Y4M) {
+        stream.open(path, std::ios::binary | std::ios::trunc);
+        if (stream) {
+            stream << "YUV4MPEG2 W" << frameSize.x << " H" << frameSize.y << " F" << framesPerSecond
+                   << ":1 Ip A1:1 C420jpeg\n";
+        }
+        if (!stream) {
+            std::cerr << "Cannot record: failed to open " << path << std::endl;
+            stream.close();
+            return false;
+        }
+    } else if (!std::filesystem::create_directories(path, error) && !std::filesystem::is_directory(path)) {
+        std::cerr << "Cannot record: failed to create " << path << std::endl;
+        return false;
+    }
+
+    // The frame buffers are allocated once per recording; the queue only moves pointers
+    pool.assign(poolSize, Frame());
+    freeFrames.clear();
+    queuedFrames.clear();
+    writingRepeats = 0;
+    for (Frame& frame : pool) {
+        frame.pixels.resize(static_cast<size_t>(windowSize.x) * windowSize.y * 4);
+        freeFrames.push_back(&frame);
+    }
+    this->format = format;
+    this->windowSize = windowSize;
+    this->frameSize = frameSize;
+    outputPath = path;
+    framesCaptured = 0;
+    framesDropped = 0;
+    framesWritten = 0;
+    framesRepeated = 0;
+    stopping = false;
+    active = true;
+    worker = std::thread(&FrameCapture::workerLoop, this);
+
+    std::cout << "Recording " << frameSize.x << "x" << frameSize.y << " at " << framesPerSecond
+              << " fps to " << outputPath << std::endl;
+    return true;
+}
+
+void FrameCapture::stop() {
+    if (!active) return;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    workAvailable.notify_one();
+    if (worker.joinable()) worker.join();
+    if (stream.is_open()) stream.close();
+    active = false;
+
+    std::cout << "Recording stopped: " << getFramesWritten() << " frames written, " << framesDropped
+              << " dropped (" << getFramesRepeated() << " filled by repeating the previous frame), in "
+              << outputPath << std::endl;
+    pool.clear();
+    pool.shrink_to_fit();
+    freeFrames.clear();
+}
+
+void FrameCapture::dropFrame() {
+    framesDropped++;
+    framesCaptured++;
+    // Nothing is queued for a drop; it only counts against the frame before it
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (!queuedFrames.empty()) {
+            queuedFrames.back().repeats++;
+            return;
+        }
+        writingRepeats++;
+    }
+    workAvailable.notify_one(); // An idle worker fills it right away
+}
+
+void FrameCapture::capture(const sf::RenderWindow& window) {
+    if (!active) return;
+    if (window.getSize() != windowSize) {
+        dropFrame();
+        return;
+    }
+
+    Frame* frame = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (!freeFrames.empty()) {
+            frame = freeFrames.back();
+            freeFrames.pop_back();
+        }
+    }
+    if (!frame) {
+        dropFrame(); // The worker is behind; checked before reading back, so a dropped frame costs nothing
+        return;
+    }
+
+    // SFML only reads back synchronously; conversion and writing happen on the worker
+    readbackTexture.update(window);
+    const sf::Image image = readbackTexture.copyToImage();
+    if (const std::uint8_t* pixels = image.getPixelsPtr()) {
+        std::memcpy(frame->pixels.data(), pixels, std::min(frame->pixels.size(), static_cast<size_t>(image.getSize().x) * image.getSize().y * 4));
+    }
+    framesCaptured++;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queuedFrames.push_back({frame, 0});
+    }
+    workAvailable.notify_one();
+}
+
+void FrameCapture::workerLoop() {
+    std::vector<std::uint8_t> converted; // The frame last written, kept for repeats
+    bool haveConverted = false;
+    bool failed = false;
+    uint64_t outputNumber = 0;
+    auto write = [&]() {
+        if (failed) return false;
+        if (!writeConverted(converted, outputNumber)) {
+            failed = true; // Keep returning buffers so capture() just drops frames
+            std::cerr << "Error writing frame " << outputNumber << " to " << outputPath
+                      << "; recording no longer writes." << std::endl;
+            return false;
+        }
+        outputNumber++;
+        framesWritten.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    };
+
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true) {
+        workAvailable.wait(lock, [this] { return stopping || !queuedFrames.empty() || writingRepeats > 0; });
+        if (!queuedFrames.empty()) {
+            const QueuedFrame next = queuedFrames.front();
+            queuedFrames.pop_front();
+            // Repeats still owed to the previous frame are skipped: a captured frame was waiting, so the
+            // writer is behind and gets the time back. Drops from now on, while nothing is queued, count here.
+            writingRepeats = next.repeats;
+            lock.unlock();
+
+            convertFrame(*next.frame, converted);
+            write();
+            haveConverted = true;
+
+            lock.lock();
+            freeFrames.push_back(next.frame);
+        } else if (stopping) {
+            return; // Everything captured is written; repeats owed to the last frame are skipped
+        } else {
+            // Caught up: fill one dropped frame by writing the last one again
+            writingRepeats--;
+            if (!haveConverted) continue; // Dropped before the first frame; the recording starts later
+            lock.unlock();
+            if (write()) framesRepeated.fetch_add(1, std::memory_order_relaxed);
+            lock.lock();
+        }
+    }
+}
+
+bool FrameCapture::writeConverted(const std::vector<std::uint8_t>& converted, uint64_t outputNumber) {
+    if (format == Format::PPM_SEQUENCE) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%06llu.ppm", static_cast<unsigned long long>(outputNumber));
+        std::ofstream file(outputPath / name, std::ios::binary | std::ios::trunc);
+        file << "P6\n" << frameSize.x << " " << frameSize.y << "\n255\n";
+        file.write(reinterpret_cast<const char*>(converted.data()), static_cast<std::streamsize>(converted.size()));
+        return static_cast<bool>(file);
+    }
+    stream << "FRAME\n";
+    stream.write(reinterpret_cast<const char*>(converted.data()), static_cast<std::streamsize>(converted.size()));
+    return static_cast<bool>(stream);
+}
+
+void FrameCapture::convertFrame(const Frame& frame, std::vector<std::uint8_t>& scratch) const {
+    const size_t width = frameSize.x;
+    const size_t height = frameSize.y;
+    const size_t stride = static_cast<size_t>(windowSize.x) * 4;
+    const std::uint8_t* rgba = frame.pixels.data();
+
+    if (format == Format::PPM_SEQUENCE) {
+        scratch.resize(width * height * 3);
+        for (size_t y = 0; y < height; ++y) {
+            const std::uint8_t* source = rgba + y * stride;
+            std::uint8_t* target = scratch.data() + y * width * 3;
+            for (size_t x = 0; x < width; ++x) {
+                target[x * 3 + 0] = source[x * 4 + 0];
+                target[x * 3 + 1] = source[x * 4 + 1];
+                target[x * 3 + 2] = source[x * 4 + 2];
+            }
+        }
+        return;
+    }
+
+    // Full-range BT.601 (what C420jpeg means), chroma averaged over each 2x2 block
+    const size_t lumaSize = width * height;
+    const size_t chromaWidth = width / 2;
+    const size_t chromaSize = chromaWidth * (height / 2);
+    scratch.resize(lumaSize + 2 * chromaSize);
+    std::uint8_t* lumaPlane = scratch.data();
+    std::uint8_t* bluePlane = lumaPlane + lumaSize;
+    std::uint8_t* redPlane = bluePlane + chromaSize;
+    auto clampByte = [](float value) {
+        return static_cast<std::uint8_t>(std::clamp(value + 0.5f, 0.0f, 255.0f));
+    };
+    for (size_t y = 0; y < height; ++y) {
+        const std::uint8_t* source = rgba + y * stride;
+        for (size_t x = 0; x < width; ++x) {
+            lumaPlane[y * width + x] = clampByte(0.299f * source[x * 4] + 0.587f * source[x * 4 + 1] + 0.114f * source[x * 4 + 2]);
+        }
+    }
+    for (size_t y = 0; y < height / 2; ++y) {
+        const std::uint8_t* top = rgba + (y * 2) * stride;
+        const std::uint8_t* bottom = top + stride;
+        for (size_t x = 0; x < chromaWidth; ++x) {
+            const size_t left = x * 8;
+            const float r = (top[left] + top[left + 4] + bottom[left] + bottom[left + 4]) / 4.0f;
+            const float g = (top[left + 1] + top[left + 5] + bottom[left + 1] + bottom[left + 5]) / 4.0f;
+            const float b = (top[left + 2] + top[left + 6] + bottom[left + 2] + bottom[left + 6]) / 4.0f;
+            bluePlane[y * chromaWidth + x] = clampByte(128.0f - 0.168736f * r - 0.331264f * g + 0.5f * b);
+            redPlane[y * chromaWidth + x] = clampByte(128.0f + 0.5f * r - 0.418688f * g - 0.081312f * b);
+        }
+    }
+}
@@ -5,6 +5,8 @@
 #include "Network.hpp"
 #include "Visualizer.hpp"
 #include "Utils.hpp"
+#include "TrainingCheckpoint.hpp"
+#include "Profiler.hpp"
 
 #include <SFML/Window/Event.hpp>
 #include <SFML/Graphics/Text.hpp>
@@ -12,10 +14,12 @@
 #include <limits>
 #include <algorithm>
 #include <sstream>
-#include <iomanip>
 #include <cstdio>
 #include <random>
 #include <filesystem>
+#include <unordered_map>
+#include <chrono>
+#include <ctime>
 
 
 Game::Game()
@@ -36,7 +40,8 @@ Game::Game()
     generationCount(1),
     isPaused(false),
     manualNavigationActive(false),
-    currentNavIndex(-1)
+    currentNavIndex(-1),
+    profilerText(font, "", 12)
 
 {
     std::cout << "Game constructor called." << std::endl;
@@ -50,7 +55,7 @@ Game::Game()
 
 
 Game::~Game() {
-
+    stopSimulationThread();
 
     std::cout << "Game destructor called." << std::endl;
 }
@@ -263,8 +268,16 @@ void Game::initializeSimulation() {
     averageFitnessHistory.clear();
     bestFitnessHistory.clear();
     mutationRateHistory.clear();
+    islandBestHistory.clear();
+    islandGlobalBestHistory.clear();
+    graphDataVersion++;
     currentMutationRate = INITIAL_MUTATION_RATE;
 
+    convergenceClock.restart();
+    convergenceSecondsBeforeResume = 0.0f;
+    convergenceStartGeneration = 1;
+    targetReachedGeneration = -1;
+
     updateGraphData(0.0f, 0.0f, currentMutationRate);
 
 
@@ -279,6 +292,11 @@ void Game::initializeSimulation() {
 
 
     populateCarVector(NUM_AI_CARS, START_Y_POSITION);
+    liveChunks.clear();
+    obstacleStreamer.reset(); // The old worker may still read the old bank
+    islandModel.reset();      // Same for the island threads
+    setupScenarioBank();
+    obstacleStreamer = std::make_unique<ObstacleStreamer>(road.left, road.width, road.laneCount, COURSE_LAYOUT);
 
 
     bestBrainOfGeneration = std::make_unique<NeuralNetwork>(networkStructure);
@@ -333,7 +351,16 @@ void Game::initializeSimulation() {
     }
 
 
-    generateInitialObstacles(NUM_OBSTACLES, -1500.0f, -100.0f, 20.0f, 40.0f, 40.0f, 80.0f);
+    if (loadSpecificBrainOnStart || !resumeFromCheckpoint()) {
+        startNextCourse();
+    }
+    generationSimulatedSeconds = 0.0f;
+    simulationTimeAccumulator = 0.0f;
+    halvingRung = 0;
+    halvingActive = successiveHalvingEnabled && !loadSpecificBrainOnStart;
+    nextPruneCheckSeconds = PRUNE_CHECK_INTERVAL_SECONDS;
+    generationTicksSimulated = 0;
+    prepareGenerationEvaluation();
 
 
     focusedCar = cars.empty() ? nullptr : cars[0].get();
@@ -346,10 +373,29 @@ void Game::initializeSimulation() {
 
 void Game::run() {
     std::cout << "Starting game loop..." << std::endl;
+    Profiler::instance().attachThread(ProfileTrack::RENDER);
     while (window.isOpen()) {
         sf::Time deltaTime = clock.restart();
 
         processEvents();
+        if (!window.isOpen()) break;
+
+        // Nothing on screen would change: sleep in the event queue instead of redrawing the same frame.
+        // In SIMULATION that means paused, and the simulation then only publishes in reply to a key.
+        if (!needsRedraw()) {
+            if (awaitingPausedSnapshot) {
+                awaitingPausedSnapshot = false;
+                std::unique_lock<std::mutex> lock(commandMutex);
+                pausedSnapshotPublished.wait_for(lock, std::chrono::duration<float>(PAUSED_REPLY_TIMEOUT_SECONDS),
+                                                 [this] { return snapshots.hasUnread(); });
+                continue; // Draws the reply, if it came
+            }
+            const std::optional<sf::Event> event = window.waitEvent();
+            if (event) handleEvent(*event);
+            clock.restart(); // Idle time is not frame time
+            continue;
+        }
+        redrawNeeded = false;
 
 
         window.clear(sf::Color::Black);
@@ -362,10 +408,14 @@ void Game::run() {
                 break;
 
             case GameState::SIMULATION:
-                if (!isPaused) {
-                    updateSimulation(deltaTime);
-                }
+                if (!simulationThread.joinable()) startSimulationThread();
+                worstFrameSecondsSinceRateUpdate = std::max(worstFrameSecondsSinceRateUpdate, deltaTime.asSeconds());
+                Profiler::instance().beginFrame();
                 renderSimulation();
+                {
+                    PROFILE_SCOPE(ProfilePhase::PRESENT);
+                    frameCapture.capture(window); // Reads the frame drawn above, before display() swaps it away
+                }
                 break;
 
             case GameState::HELP:
@@ -375,59 +425,97 @@ void Game::run() {
         }
 
 
-        window.display();
+        {
+            PROFILE_SCOPE(ProfilePhase::PRESENT);
+            window.display();
+        }
+        Profiler::instance().endFrame(); // Ignored unless the frame was a simulation frame
     }
+    Profiler::instance().detachThread();
+    stopSimulationThread();
+    frameCapture.stop();
     std::cout << "Exiting game loop." << std::endl;
 }
 
+bool Game::needsRedraw() const {
+    if (redrawNeeded) return true;
+    if (currentState != GameState::SIMULATION) return false; // The menu and help only change on input
+    // A paused simulation publishes snapshots only when something changed
+    return !simulationThread.joinable() || !simulationPausedOnScreen || snapshots.hasUnread() ||
+           !cameraSettled || frameCapture.isActive();
+}
+
 void Game::processEvents() {
     while (const auto eventOpt = window.pollEvent()) {
-        const sf::Event& event = *eventOpt;
+        handleEvent(*eventOpt);
+        if (!window.isOpen()) return;
+    }
+}
 
-        if (event.is<sf::Event::Closed>()) {
-            std::cout << "Window close event received." << std::endl;
-            window.close();
-            return;
-        }
+void Game::handleEvent(const sf::Event& event) {
+    redrawNeeded = true; // Input or a resize; either may change what is on screen
 
+    if (event.is<sf::Event::Closed>()) {
+        std::cout << "Window close event received." << std::endl;
+        window.close();
+        return;
+    }
 
-        switch (currentState) {
-            case GameState::MENU:
-                if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
-                    handleMenuKeyPress(*keyPressed);
-                }
-                break;
 
-            case GameState::SIMULATION:
-                if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+    switch (currentState) {
+        case GameState::MENU:
+            if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+                handleMenuKeyPress(*keyPressed);
+            }
+            break;
+
+        case GameState::SIMULATION:
+            if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+                if (keyPressed->code == sf::Keyboard::Key::Escape) {
+                    // Leaving changes state this thread owns, so the simulation stops first
+                    stopSimulationThread();
+                    frameCapture.stop();
                     handleSimulationKeyPress(*keyPressed);
+                } else if (keyPressed->code == sf::Keyboard::Key::V) {
+                    toggleRecording(); // Recording belongs to this thread, which draws the frames
+                } else if (keyPressed->code == sf::Keyboard::Key::F3) {
+                    profilerOverlayVisible = !profilerOverlayVisible;
+                } else if (keyPressed->code == sf::Keyboard::Key::F4) {
+                    dumpProfile();
+                } else {
+                    {
+                        std::lock_guard<std::mutex> lock(commandMutex);
+                        pendingKeyPresses.push_back(*keyPressed);
+                    }
+                    commandAvailable.notify_one(); // Wakes a paused simulation
+                    awaitingPausedSnapshot = true;
                 }
+            }
 
-                break;
+            break;
 
-            case GameState::HELP:
-                if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+        case GameState::HELP:
+            if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
 
-                    if (keyPressed->code == sf::Keyboard::Key::Escape || keyPressed->code == sf::Keyboard::Key::Enter) {
-                        std::cout << "Exiting help screen." << std::endl;
-                        currentState = GameState::MENU;
-                    }
+                if (keyPressed->code == sf::Keyboard::Key::Escape || keyPressed->code == sf::Keyboard::Key::Enter) {
+                    std::cout << "Exiting help screen." << std::endl;
+                    currentState = GameState::MENU;
                 }
+            }
 
-                if (event.is<sf::Event::Resized>()) {
+            if (event.is<sf::Event::Resized>()) {
 
-                    if(helpTextureLoaded) {
-                        sf::Vector2u texSize = helpTexture.getSize();
-                        sf::Vector2u winSize = window.getSize();
-                        float scaleX = (float)winSize.x / texSize.x * 0.9f;
-                        float scaleY = (float)winSize.y / texSize.y * 0.9f;
-                        float scale = std::min({scaleX, scaleY, 1.0f});
-                        helpSprite.setScale({scale, scale});
-                        helpSprite.setPosition({winSize.x / 2.f, winSize.y / 2.f});
-                    }
+                if(helpTextureLoaded) {
+                    sf::Vector2u texSize = helpTexture.getSize();
+                    sf::Vector2u winSize = window.getSize();
+                    float scaleX = (float)winSize.x / texSize.x * 0.9f;
+                    float scaleY = (float)winSize.y / texSize.y * 0.9f;
+                    float scale = std::min({scaleX, scaleY, 1.0f});
+                    helpSprite.setScale({scale, scale});
+                    helpSprite.setPosition({winSize.x / 2.f, winSize.y / 2.f});
                 }
-                break;
-        }
+            }
+            break;
     }
 }
 
@@ -486,6 +574,7 @@ void Game::handleMenuKeyPress(const sf::Event::KeyPressed& keyEvent) {
 
 void Game::handleSimulationKeyPress(const sf::Event::KeyPressed& keyEvent) {
     bool isCtrlOrCmd = keyEvent.control || keyEvent.system;
+    statusPanelDirty = true; // Most keys change something the panel shows
 
     switch (keyEvent.code) {
         case sf::Keyboard::Key::S:
@@ -506,6 +595,27 @@ void Game::handleSimulationKeyPress(const sf::Event::KeyPressed& keyEvent) {
             std::cout << "'Reset Generation' key pressed." << std::endl;
             resetGeneration();
             break;
+        case sf::Keyboard::Key::C:
+            std::cout << "'Cycle Course Mode' key pressed." << std::endl;
+            cycleCourseMode();
+            break;
+        case sf::Keyboard::Key::E:
+            std::cout << "'Robust Evaluation' key pressed." << std::endl;
+            toggleRobustEvaluation();
+            break;
+        case sf::Keyboard::Key::X:
+            std::cout << "'Cycle Selection' key pressed." << std::endl;
+            cycleCrossoverMode();
+            break;
+        case sf::Keyboard::Key::H:
+            successiveHalvingEnabled = !successiveHalvingEnabled;
+            std::cout << "Successive halving " << (successiveHalvingEnabled ? "enabled" : "disabled")
+                      << " (from the next generation)." << std::endl;
+            break;
+        case sf::Keyboard::Key::I:
+            std::cout << "'Island Model' key pressed." << std::endl;
+            toggleIslandModel();
+            break;
         case sf::Keyboard::Key::N:
         case sf::Keyboard::Key::B:
             std::cout << "'Navigate Focus' key pressed (N/B)." << std::endl;
@@ -541,127 +651,583 @@ void Game::updateMenu() {
 
 
 void Game::updateSimulation(sf::Time deltaTime) {
+    // Fixed steps: a genome then scores the same on a course whatever the frame rate,
+    // which is what makes cached fitness valid
+    simulationTimeAccumulator += std::min(deltaTime.asSeconds(), SIMULATION_TIME_STEP * MAX_SIMULATION_STEPS_PER_FRAME);
+    while (simulationTimeAccumulator >= SIMULATION_TIME_STEP) {
+        simulationTimeAccumulator -= SIMULATION_TIME_STEP;
+        stepsSinceRateUpdate++;
+        if (stepSimulation()) {
+            simulationTimeAccumulator = 0.0f;
+            break;
+        }
+    }
+
+    updateFocus();
+    updateStatusPanel();
+}
+
+void Game::startSimulationThread() {
+    {
+        std::lock_guard<std::mutex> lock(commandMutex);
+        pendingKeyPresses.clear();
+    }
+    stepRateClock.restart();
+    stepsSinceRateUpdate = 0;
+    stepsPerSecond = 0.0f;
+    statusPanelDirty = true;
+    updateStatusPanel();
+    publishSnapshot(); // The first frame then already draws this session, not a stale one
+
+    simulationThreadStopping = false;
+    simulationThread = std::thread(&Game::simulationThreadLoop, this);
+    std::cout << "Simulation thread started." << std::endl;
+}
+
+void Game::stopSimulationThread() {
+    if (!simulationThread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(commandMutex); // So a paused thread cannot miss the wake-up
+        simulationThreadStopping = true;
+    }
+    commandAvailable.notify_one();
+    simulationThread.join();
+    cancelRobustEvaluation(); // Its workers read the genome copies and the bank
+    pendingGenerationEnd = GenerationEnd::NONE;
+    std::cout << "Simulation thread stopped." << std::endl;
+}
 
+void Game::simulationThreadLoop() {
+    std::vector<sf::Event::KeyPressed> keyPresses;
+    sf::Clock stepClock;
+    Profiler& profiler = Profiler::instance();
+    profiler.attachThread(ProfileTrack::SIMULATION);
+    if (!pendingRandomState.empty()) {
+        // Mutation and course seeds are drawn on this thread, so this is the engine the checkpoint saved
+        if (!setRandomState(pendingRandomState)) {
+            std::cerr << "Warning: Checkpoint RNG state unreadable; continuing with a fresh seed." << std::endl;
+        }
+        pendingRandomState.clear();
+    }
+    while (!simulationThreadStopping) {
+        {
+            std::lock_guard<std::mutex> lock(commandMutex);
+            keyPresses.swap(pendingKeyPresses);
+        }
+        const bool handledKeys = !keyPresses.empty();
+        for (const sf::Event::KeyPressed& keyPress : keyPresses) {
+            handleSimulationKeyPress(keyPress);
+        }
+        keyPresses.clear();
 
+        if (stepRateClock.getElapsedTime().asSeconds() >= 1.0f) {
+            stepsPerSecond = static_cast<float>(stepsSinceRateUpdate) / stepRateClock.restart().asSeconds();
+            stepsSinceRateUpdate = 0;
+        }
 
+        const sf::Time elapsed = stepClock.restart();
+        if (!isPaused) {
+            profiler.beginFrame();
+            updateSimulation(elapsed);
+            {
+                PROFILE_SCOPE(ProfilePhase::SNAPSHOT);
+                publishSnapshot();
+            }
+            profiler.endFrame();
+
+            // Real-time pacing as before: wake when the next fixed step is due, so a key press
+            // waits at most one step
+            const float untilNextStep = SIMULATION_TIME_STEP - simulationTimeAccumulator;
+            std::this_thread::sleep_for(std::chrono::duration<float>(std::max(0.0f, untilNextStep)));
+        } else {
+            // Paused: nothing changes but through keys, so publish once per batch of keys and sleep
+            // until the next one; the status panel is not refreshed on a timer meanwhile
+            if (handledKeys) {
+                statusPanelDirty = true;
+                updateStatusPanel();
+                publishSnapshot();
+            }
+
+            std::unique_lock<std::mutex> lock(commandMutex);
+            if (handledKeys) pausedSnapshotPublished.notify_one();
+            commandAvailable.wait(lock, [this] { return simulationThreadStopping || !pendingKeyPresses.empty(); });
+            stepClock.restart(); // Resuming continues from now, not from before the wait
+        }
+    }
+    profiler.detachThread();
+}
+
+void Game::toggleRecording() {
+    if (frameCapture.isActive()) {
+        frameCapture.stop();
+    } else {
+        frameCapture.start(CAPTURE_DIRECTORY, CAPTURE_FORMAT, window.getSize(), CAPTURE_FRAMES_PER_SECOND);
+    }
+}
+
+void Game::publishSnapshot() {
+    WorldSnapshot& snapshot = snapshots.writeSlot();
+
+    // Retired cars are not drawn, except the focused one
+    snapshot.cars.clear();
+    snapshot.focusedCar = -1;
+    for (const auto& carPtr : cars) {
+        if (!carPtr || (carPtr->isRetired() && carPtr.get() != focusedCar)) continue;
+        if (carPtr.get() == focusedCar) snapshot.focusedCar = static_cast<int>(snapshot.cars.size());
+        snapshot.cars.push_back({carPtr->position, carPtr->angle, carPtr->width, carPtr->height, carPtr->getDrawColor()});
+    }
+
+    snapshot.focusedSensor.clear();
+    snapshot.focusedSensorReach = 0.0f;
+    snapshot.hasFocusedBrain = false;
+    if (focusedCar) {
+        focusedCar->appendSensorVertices(snapshot.focusedSensor);
+        snapshot.focusedSensorReach = focusedCar->getSensorRayLength() + std::hypot(focusedCar->width, focusedCar->height) / 2.0f;
+        if (focusedCar->useBrain && focusedCar->brain && !focusedCar->brain->levels.empty()) {
+            // Assigning into the slot's network reuses its storage once the shapes match
+            if (snapshot.focusedBrain) {
+                *snapshot.focusedBrain = *focusedCar->brain;
+            } else {
+                snapshot.focusedBrain.emplace(*focusedCar->brain);
+            }
+            snapshot.hasFocusedBrain = true;
+        }
+    }
+
+    snapshot.obstacles.clear();
+    for (const auto& obstacle : obstacles) {
+        snapshot.obstacles.push_back({obstacle->position, obstacle->width, obstacle->height, obstacle->color});
+    }
+    snapshot.chunks.clear();
+    for (const ObstacleChunk& chunk : liveChunks) {
+        snapshot.chunks.push_back({chunk.index, chunk.specs.size()});
+    }
+
+    // The histories change once per generation and the text a few times a second
+    if (snapshot.historyVersion != graphDataVersion) {
+        snapshot.historyVersion = graphDataVersion;
+        snapshot.averageFitnessHistory = averageFitnessHistory;
+        snapshot.bestFitnessHistory = bestFitnessHistory;
+        snapshot.mutationRateHistory = mutationRateHistory;
+        snapshot.islandBestHistory = islandBestHistory;
+        snapshot.islandGlobalBestHistory = islandGlobalBestHistory;
+    }
+    snapshot.islandModelActive = islandModel != nullptr;
+    snapshot.paused = isPaused;
+    if (snapshot.statusVersion != statusVersion) {
+        snapshot.statusVersion = statusVersion;
+        snapshot.status = statusString;
+    }
+
+    snapshots.publish();
+}
+
+bool Game::stepSimulation() {
+    GenerationEnd end = pendingGenerationEnd;
+    if (end == GenerationEnd::NONE) {
+        end = advanceGeneration();
+        if (end == GenerationEnd::NONE) return false;
+        generationOnScreenMs = robustEvaluationClock.getElapsedTime().asSeconds() * 1000.0f;
+    }
+    if (robustEvaluationPending()) {
+        // The cars stop here; selection waits for the bank scores the workers are still computing
+        if (pendingGenerationEnd == GenerationEnd::NONE) {
+            std::cout << "Generation " << generationCount << " finished on screen; waiting for robust evaluation." << std::endl;
+            statusPanelDirty = true;
+        }
+        pendingGenerationEnd = end;
+        return false;
+    }
+    pendingGenerationEnd = GenerationEnd::NONE;
+    endGeneration(end);
+    return true;
+}
+
+GenerationEnd Game::advanceGeneration() {
+    const sf::Time timeStep = sf::seconds(SIMULATION_TIME_STEP);
     int nonDamagedCount = 0;
+    int nonDamagedAgents = 0;
     bool anyCarMoved = false;
-    float totalFitness = 0.0f;
-    float maxFitness = -std::numeric_limits<float>::infinity();
 
     for (auto& carPtr : cars) {
-        if (carPtr) {
+        if (carPtr && !carPtr->isDamaged()) {
             float yBefore = carPtr->position.y;
-            carPtr->update(road, obstacleRawPtrs, deltaTime);
+            carPtr->update(road, obstacleRawPtrs, timeStep);
+            generationTicksSimulated++;
             if (!carPtr->isDamaged()) {
                 nonDamagedCount++;
+                nonDamagedAgents += carPtr->getMultiplicity();
                 if (carPtr->position.y < yBefore) {
                     anyCarMoved = true;
                 }
-
-                float currentCarFitness = carPtr->getFitness();
-                totalFitness += currentCarFitness;
-                if (currentCarFitness > maxFitness) {
-                    maxFitness = currentCarFitness;
-
-                }
-            } else {
-                totalFitness += carPtr->getFitness();
-                if (carPtr->getFitness() > maxFitness) {
-                    maxFitness = carPtr->getFitness();
-                }
             }
         }
     }
+    generationSimulatedSeconds += SIMULATION_TIME_STEP;
+    aliveCarCount = nonDamagedCount;
+    aliveAgentCount = nonDamagedAgents;
+
+    if (halvingActive && halvingRung < HALVING_RUNG_SECONDS.size() &&
+        generationSimulatedSeconds >= HALVING_RUNG_SECONDS[halvingRung]) {
+        PROFILE_SCOPE(ProfilePhase::GENETIC_ALGORITHM);
+        nonDamagedCount = promoteHalvingRung();
+        countAliveCars();
+    }
+    if (!loadSpecificBrainOnStart && generationSimulatedSeconds >= nextPruneCheckSeconds) {
+        PROFILE_SCOPE(ProfilePhase::GENETIC_ALGORITHM);
+        nextPruneCheckSeconds += PRUNE_CHECK_INTERVAL_SECONDS;
+        nonDamagedCount = pruneHopelessCars();
+        countAliveCars();
+        speculateNextGeneration();
+    }
 
 
     bool allCarsDamaged = (nonDamagedCount == 0);
-    bool generationStalled = (!allCarsDamaged && !anyCarMoved && generationClock.getElapsedTime().asSeconds() > 5.0f);
-    bool timeLimitExceeded = generationClock.getElapsedTime().asSeconds() > 60.0f;
-
-    if ((allCarsDamaged || generationStalled || timeLimitExceeded) && !cars.empty()) {
-        std::cout << "\n--- GENERATION " << generationCount << " ENDED ";
-        if (timeLimitExceeded) std::cout << "(Time Limit Exceeded: >60s) ---" << std::endl;
-        else if (generationStalled) std::cout << "(Stalled) ---" << std::endl;
-        else std::cout << "(All Damaged) ---" << std::endl;
+    bool generationStalled = (!allCarsDamaged && !anyCarMoved && generationSimulatedSeconds > 5.0f);
+    bool timeLimitExceeded = generationSimulatedSeconds > SIMULATION_TIME_LIMIT_SECONDS;
 
+    if (!cars.empty()) {
+        if (timeLimitExceeded) return GenerationEnd::TIME_LIMIT;
+        if (generationStalled) return GenerationEnd::STALLED;
+        if (allCarsDamaged) return GenerationEnd::ALL_DAMAGED;
+    }
+    if (!allCarsDamaged) {
+        PROFILE_SCOPE(ProfilePhase::OBSTACLES);
+        manageInfiniteObstacles();
+    }
+    return GenerationEnd::NONE;
+}
 
-        float averageFitness = cars.empty() ? 0.0f : totalFitness / static_cast<float>(cars.size());
+void Game::endGeneration(GenerationEnd end) {
+    PROFILE_SCOPE(ProfilePhase::GENETIC_ALGORITHM);
+    sf::Clock boundaryClock;
+    statusPanelDirty = true;
+    std::cout << "\n--- GENERATION " << generationCount << " ENDED ";
+    if (end == GenerationEnd::TIME_LIMIT) std::cout << "(Time Limit Exceeded: >60s) ---" << std::endl;
+    else if (end == GenerationEnd::STALLED) std::cout << "(Stalled) ---" << std::endl;
+    else std::cout << "(All Damaged) ---" << std::endl;
+
+    // A stalled generation cuts runs short depending on the other cars, so it is not cached
+    float averageFitness = 0.0f;
+    float maxFitness = -std::numeric_limits<float>::infinity();
+    finishGenerationEvaluation(end != GenerationEnd::STALLED, averageFitness, maxFitness);
+    lastGenerationTicks = generationTicksSimulated;
+    std::cout << "Evaluation: " << generationTicksSimulated << " car ticks simulated";
+    if (halvingActive) {
+        std::cout << " (successive halving, " << countRetired(RetireReason::HALVED) << " stopped early)";
+    }
+    std::cout << ", " << countRetired(RetireReason::PRUNED) << " pruned as hopeless";
+    std::cout << std::endl;
+    if (eliteCachedFitness) {
+        maxFitness = std::max(maxFitness, *eliteCachedFitness);
+    }
 
-        updateMutationRate();
-        updateGraphData(averageFitness, maxFitness, currentMutationRate);
-        std::cout << "Stats: Avg Fitness=" << averageFitness
-                << ", Best Fitness=" << maxFitness
-                << ", Next Mut Rate=" << currentMutationRate << std::endl;
+    updateMutationRate();
+    updateGraphData(averageFitness, maxFitness, currentMutationRate);
+    updateIslandGraphData();
+    trackConvergence(maxFitness);
+    std::cout << "Stats: Scenario=" << currentScenarioId
+            << ", Avg Fitness=" << averageFitness
+            << ", Best Fitness=" << maxFitness
+            << ", Next Mut Rate=" << currentMutationRate << std::endl;
 
 
-        Car* carWithBestFitness = nullptr;
+    Car* carWithBestFitness = robustEvaluationActive ? selectRobustElite() : nullptr;
 
+    if (!carWithBestFitness) {
         for (const auto& carPtr : cars) {
             if (carPtr && carPtr->getFitness() >= maxFitness) {
                 carWithBestFitness = carPtr.get();
 
             }
         }
+    }
+    // The elite was not re-driven (its score here is cached); it stays unless an offspring beat it
+    const bool eliteKept = eliteCachedFitness && !robustEvaluationActive &&
+                           (!carWithBestFitness || *eliteCachedFitness >= carWithBestFitness->getFitness());
+
+
+    bool eliteChanged = false;
+    if (eliteKept) {
+        std::cout << "Kept elite brain (cached fitness " << *eliteCachedFitness << " on this course)" << std::endl;
+    } else if (carWithBestFitness && carWithBestFitness->brain) {
+        *bestBrainOfGeneration = *(carWithBestFitness->brain);
+        std::cout << "Selected best brain (Fitness: " << maxFitness
+                << ", Y: " << carWithBestFitness->position.y << ")" << std::endl;
+        eliteChanged = true;
+    } else {
+        std::cout << "No valid best car/brain found for this generation. Keeping previous best brain." << std::endl;
+    }
+    // The island champion has to beat the elite just selected, both scored on the islands' common set
+    eliteChanged = adoptIslandChampion() || eliteChanged;
 
-
-        if (carWithBestFitness && carWithBestFitness->brain) {
-            *bestBrainOfGeneration = *(carWithBestFitness->brain);
-            std::cout << "Selected best brain (Fitness: " << maxFitness
-                    << ", Y: " << carWithBestFitness->position.y << ")" << std::endl;
-            if (!loadSpecificBrainOnStart) {
-                saveBestBrain();
-            } else {
-                std::cout << "(Visualization mode: Not saving brain)" << std::endl;
-            }
+    if (eliteChanged) {
+        if (!loadSpecificBrainOnStart) {
+            saveBestBrain();
         } else {
-            std::cout << "No valid best car/brain found for this generation. Keeping previous best brain." << std::endl;
+            std::cout << "(Visualization mode: Not saving brain)" << std::endl;
         }
+    }
 
 
-        if (!loadSpecificBrainOnStart) {
-            std::cout << "--- Preparing Next Training Generation " << generationCount + 1 << " ---" << std::endl;
-        } else {
-            std::cout << "--- Resetting Visualization ---" << std::endl;
+    if (!loadSpecificBrainOnStart) {
+        captureMatingPool();
+        std::cout << "--- Preparing Next Training Generation " << generationCount + 1 << " ---" << std::endl;
+    } else {
+        std::cout << "--- Resetting Visualization ---" << std::endl;
+    }
+    resetGeneration();
+    if (!loadSpecificBrainOnStart && generationCount % CHECKPOINT_INTERVAL == 0) {
+        saveCheckpoint();
+    }
+    lastBoundaryMs = boundaryClock.getElapsedTime().asSeconds() * 1000.0f;
+    maxBoundaryMs = std::max(maxBoundaryMs, lastBoundaryMs);
+    std::cout << "Generation boundary took " << lastBoundaryMs << " ms (offspring "
+              << (preparedOffspringUsed ? "prepared in the background" : "built in place") << ")" << std::endl;
+}
+
+int Game::promoteHalvingRung() {
+    // Finished cars already have their final score and need no slot: the top fraction of the
+    // cars still running continue
+    std::vector<Car*> candidates;
+    for (const auto& carPtr : cars) {
+        if (carPtr && !carPtr->isDamaged()) candidates.push_back(carPtr.get());
+    }
+    // Never fewer than selection needs, or the mating pool would be ranked on truncated scores
+    const size_t promoteCount = std::max(selectionKeepCount(), static_cast<size_t>(
+        std::ceil(candidates.size() * HALVING_PROMOTE_FRACTION)));
+
+    int stoppedCount = 0;
+    if (promoteCount < candidates.size()) {
+        std::nth_element(candidates.begin(), candidates.begin() + promoteCount, candidates.end(),
+                         [](const Car* a, const Car* b) { return a->getFitness() > b->getFitness(); });
+        for (size_t i = promoteCount; i < candidates.size(); ++i) {
+            candidates[i]->retire(candidates[i]->getFitness(), RetireReason::HALVED);
+            stoppedCount++;
         }
-        resetGeneration();
+    }
 
-    } else if (!allCarsDamaged) {
-        manageInfiniteObstacles();
+    const int runningCount = static_cast<int>(candidates.size()) - stoppedCount;
+    std::cout << "Halving rung " << halvingRung << " (" << HALVING_RUNG_SECONDS[halvingRung] << "s): promoted "
+              << std::min(promoteCount, candidates.size()) << " of " << candidates.size()
+              << ", stopped " << stoppedCount << ", " << runningCount << " still running" << std::endl;
+    halvingRung++;
+    return runningCount;
+}
+
+size_t Game::selectionKeepCount() const {
+    // With robust evaluation the on-screen scores do not select at all; the elite-clone scheme
+    // only needs the best car. Multi-parent breeding ranks the whole mating pool, and the elite
+    // (which is left out of the pool) may hold one of the top places.
+    if (robustEvaluationActive || selectionSettings.matingPoolSize <= 1) return 1;
+    return static_cast<size_t>(selectionSettings.matingPoolSize) + 1;
+}
+
+int Game::pruneHopelessCars() {
+    // A running car whose best possible ending is below the K-th best worst possible ending of
+    // the others can never be selected, so it is stopped
+    const size_t keepCount = selectionKeepCount();
+    const float remainingSeconds = SIMULATION_TIME_LIMIT_SECONDS - generationSimulatedSeconds;
+
+    std::vector<float> lowerBounds;
+    lowerBounds.reserve(cars.size() + 1);
+    for (const auto& carPtr : cars) {
+        if (!carPtr || carPtr->getRetireReason() == RetireReason::MERGED) continue;
+        lowerBounds.push_back(carPtr->isRetired() ? carPtr->getFitness()
+                                                  : carPtr->getFitnessLowerBound(remainingSeconds, SIMULATION_TIME_STEP));
     }
+    if (eliteCachedFitness) lowerBounds.push_back(*eliteCachedFitness);
 
-    updateFocus();
-    updateStatusPanel();
+    int runningCount = 0;
+    if (lowerBounds.size() <= keepCount) {
+        for (const auto& carPtr : cars) {
+            if (carPtr && !carPtr->isDamaged()) runningCount++;
+        }
+        return runningCount;
+    }
+    std::nth_element(lowerBounds.begin(), lowerBounds.begin() + (keepCount - 1), lowerBounds.end(), std::greater<float>());
+    const float threshold = lowerBounds[keepCount - 1];
+
+    const float laneWidth = road.width / static_cast<float>(road.laneCount);
+    int prunedCount = 0;
+    for (const auto& carPtr : cars) {
+        if (!carPtr || carPtr->isDamaged()) continue;
+        // Chunks hold at most obstaclesPerChunk obstacles; the travel may touch one partial chunk at each end
+        const float travel = carPtr->getMaxTravel(remainingSeconds, SIMULATION_TIME_STEP);
+        const int maxOvertakes = static_cast<int>(std::ceil(travel / COURSE_LAYOUT.chunkLength) + 1.0f) * COURSE_LAYOUT.obstaclesPerChunk;
+        if (carPtr->getFitnessUpperBound(remainingSeconds, SIMULATION_TIME_STEP, laneWidth, maxOvertakes) < threshold) {
+            carPtr->retire(carPtr->getFitness(), RetireReason::PRUNED);
+            prunedCount++;
+            prunedThisGeneration++;
+        } else {
+            runningCount++;
+        }
+    }
+    if (prunedCount > 0) {
+        std::cout << "Pruned " << prunedCount << " hopeless cars at " << generationSimulatedSeconds
+                  << "s, " << runningCount << " still running" << std::endl;
+    }
+    return runningCount;
 }
 
-void Game::updateMutationRate() {
-    if (loadSpecificBrainOnStart) {
-        currentMutationRate = 0.0f;
+void Game::speculateNextGeneration() {
+    // Robust evaluation ranks the generation on scores that only exist at the boundary
+    if (loadSpecificBrainOnStart || cars.size() < 2 || robustEvaluationActive) return;
+    // Guess the next elite from the running leader; take() only uses the buffer if the guess holds
+    const Car* leader = nullptr;
+    for (const auto& carPtr : cars) {
+        if (carPtr && carPtr->brain && carPtr->getRetireReason() != RetireReason::MERGED &&
+            (!leader || carPtr->getFitness() > leader->getFitness())) {
+            leader = carPtr.get();
+        }
+    }
+    const NeuralNetwork* parent = leader ? &*leader->brain : nullptr;
+    if (eliteCachedFitness && (!leader || *eliteCachedFitness >= leader->getFitness())) {
+        parent = bestBrainOfGeneration.get();
+    }
+    if (!parent) return;
+    const float mutationRate = mutationRateForGeneration(generationCount);
+    if (selectionSettings.matingPoolSize <= 1) {
+        generationPreparer.prepare(*parent, mutationRate, cars.size() - 1);
         return;
     }
+    // Tournaments only compare fitness, so the offspring hold if the pool keeps its members and order
+    std::vector<float> carFitness(cars.size(), -std::numeric_limits<float>::infinity());
+    for (size_t i = 0; i < cars.size(); ++i) {
+        if (cars[i] && cars[i]->brain && cars[i]->getRetireReason() != RetireReason::MERGED) {
+            carFitness[i] = cars[i]->getFitness();
+        }
+    }
+    speculatedMatingPool.clear();
+    speculatedMatingPoolFitness.clear();
+    collectMatingPool(*parent, carFitness, speculatedMatingPool, speculatedMatingPoolFitness);
+    generationPreparer.prepareBred(speculatedMatingPool, speculatedMatingPoolFitness, mutationRate, selectionSettings,
+                                   cars.size() - 1);
+}
 
-    currentMutationRate = MIN_MUTATION_RATE +
-                        (INITIAL_MUTATION_RATE - MIN_MUTATION_RATE) *
-                        std::exp(-MUTATION_DECAY_FACTOR * static_cast<float>(generationCount));
-
+void Game::countAliveCars() {
+    aliveCarCount = 0;
+    aliveAgentCount = 0;
+    for (const auto& carPtr : cars) {
+        if (carPtr && !carPtr->isDamaged()) {
+            aliveCarCount++;
+            aliveAgentCount += carPtr->getMultiplicity();
+        }
+    }
+}
 
-    currentMutationRate = std::max(MIN_MUTATION_RATE, currentMutationRate);
+int Game::countRetired(RetireReason reason) const {
+    int count = 0;
+    for (const auto& carPtr : cars) {
+        if (carPtr && carPtr->getRetireReason() == reason) count++;
+    }
+    return count;
 }
-void Game::updateGraphData(float avgFit, float bestFit, float mutRate) {
-    averageFitnessHistory.push_back(avgFit);
-    bestFitnessHistory.push_back(bestFit);
-    mutationRateHistory.push_back(mutRate);
 
+void Game::prepareGenerationEvaluation() {
+    carGenomeHashes.assign(cars.size(), 0);
+    duplicateLeaders.assign(cars.size(), -1);
+    eliteCachedFitness.reset();
+    robustCarFitness.clear();
+    robustEvaluationActive = robustEvaluationEnabled && !loadSpecificBrainOnStart && !islandModel &&
+                             scenarioBank && scenarioBank->size() > 0;
+
+    // Visualisation must actually drive the course; with robust evaluation the elite must stay in
+    // the population, as selection only sees the genomes the workers score
+    const bool useCache = !loadSpecificBrainOnStart && !robustEvaluationActive;
+    const uint64_t eliteHash = bestBrainOfGeneration ? bestBrainOfGeneration->getGenomeHash() : 0;
+    std::unordered_map<uint64_t, int> firstCarWithAgent;
+    int cachedCount = 0;
+    int mergedCount = 0;
+
+    for (size_t i = 0; i < cars.size(); ++i) {
+        Car* car = cars[i].get();
+        if (!car || !car->brain) continue;
+        uint64_t hash = (i < preparedGenomeHashes.size()) ? preparedGenomeHashes[i] : car->brain->getGenomeHash();
+
+        if (useCache) {
+            if (std::optional<float> known = fitnessCache.find(hash, courseSeed)) {
+                if (hash == eliteHash && !eliteCachedFitness) {
+                    // The elite's score here is known, so its slot takes one more offspring
+                    eliteCachedFitness = *known;
+                    NeuralNetwork::mutate(*car->brain, currentMutationRate);
+                    hash = car->brain->getGenomeHash();
+                } else {
+                    car->retire(*known, RetireReason::CACHED);
+                    carGenomeHashes[i] = hash;
+                    cachedCount++;
+                    continue;
+                }
+            }
+        }
 
-    while (averageFitnessHistory.size() > MAX_HISTORY_POINTS) {
-        averageFitnessHistory.pop_front();
+        carGenomeHashes[i] = hash;
+        // Same genome from the same state on the same course gives the same trajectory: drive it once
+        const uint64_t agentKey = hash ^ (car->getStateHash() * 0x9E3779B97F4A7C15ull);
+        auto first = firstCarWithAgent.emplace(agentKey, static_cast<int>(i));
+        if (!first.second) {
+            // The key is only a hash: merge only once genome and state are confirmed identical
+            Car& leader = *cars[first.first->second];
+            if (!car->sameState(leader) || !car->brain->sameGenome(*leader.brain)) continue;
+            duplicateLeaders[i] = first.first->second;
+            car->mergeInto(leader);
+            mergedCount++;
+        }
     }
-    while (bestFitnessHistory.size() > MAX_HISTORY_POINTS) {
-        bestFitnessHistory.pop_front();
+
+    preparedGenomeHashes.clear();
+    prunedThisGeneration = 0;
+    countAliveCars();
+    if (robustEvaluationActive) {
+        startRobustEvaluation();
+    } else {
+        cancelRobustEvaluation();
     }
-    while (mutationRateHistory.size() > MAX_HISTORY_POINTS) {
-        mutationRateHistory.pop_front();
+
+    std::cout << "Evaluation plan: " << (static_cast<int>(cars.size()) - cachedCount - mergedCount)
+              << " simulated, " << mergedCount << " merged into identical agents, " << cachedCount << " cached"
+              << (eliteCachedFitness ? ", elite cached (slot reused)" : "") << std::endl;
+}
+
+void Game::finishGenerationEvaluation(bool cacheResults, float& averageFitness, float& maxFitness) {
+    for (size_t i = 0; i < cars.size() && i < duplicateLeaders.size(); ++i) {
+        if (cars[i] && duplicateLeaders[i] >= 0 && cars[duplicateLeaders[i]]) {
+            cars[i]->splitFrom(*cars[duplicateLeaders[i]]);
+        }
+    }
+
+    float totalFitness = 0.0f;
+    maxFitness = -std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < cars.size(); ++i) {
+        if (!cars[i]) continue;
+        const float fitness = cars[i]->getFitness();
+        totalFitness += fitness;
+        maxFitness = std::max(maxFitness, fitness);
+        if (cacheResults && !cars[i]->isRetired() && i < carGenomeHashes.size() && duplicateLeaders[i] < 0) {
+            fitnessCache.insert(carGenomeHashes[i], courseSeed, fitness);
+        }
+    }
+    averageFitness = cars.empty() ? 0.0f : totalFitness / static_cast<float>(cars.size());
+}
+
+
+void Game::updateMutationRate() {
+    if (loadSpecificBrainOnStart) {
+        currentMutationRate = 0.0f;
+        return;
     }
+
+    currentMutationRate = mutationRateForGeneration(generationCount);
+}
+
+float Game::mutationRateForGeneration(int generation) const {
+    return scheduledMutationRate(INITIAL_MUTATION_RATE, MIN_MUTATION_RATE, MUTATION_DECAY_FACTOR, generation);
+}
+void Game::updateGraphData(float avgFit, float bestFit, float mutRate) {
+    averageFitnessHistory.push(avgFit);
+    bestFitnessHistory.push(bestFit);
+    mutationRateHistory.push(mutRate);
+    graphDataVersion++;
 }
 
 
@@ -789,7 +1355,13 @@ void Game::renderHelp() {
 }
 
 void Game::renderSimulation() {
+    // Everything below comes from the newest snapshot; the live simulation belongs to its thread
+    const WorldSnapshot& snapshot = snapshots.read();
+    const CarPose* focusedPose = snapshot.focusedCar >= 0 ? &snapshot.cars[snapshot.focusedCar] : nullptr;
+    simulationPausedOnScreen = snapshot.paused;
 
+    PROFILE_SCOPE_NAMED(phaseTimer, ProfilePhase::RENDER_PANELS);
+    updateDisplayedStatus(snapshot);
     window.setView(statusView);
     window.draw(statusPanelBackground);
     window.draw(statusText);
@@ -797,33 +1369,45 @@ void Game::renderSimulation() {
 
     window.setView(graphView);
     window.draw(graphPanelBackground);
-    renderGraphs();
+    renderGraphs(snapshot);
 
 
-    if (focusedCar) {
+    PROFILE_SWITCH(phaseTimer, ProfilePhase::RENDER_WORLD);
+    if (focusedPose) {
         float viewCenterX = carView.getSize().x / 2.0f;
-        float targetY = focusedCar->position.y - window.getSize().y * 0.3f;
+        float targetY = focusedPose->position.y - window.getSize().y * 0.3f;
         float currentCenterY = carView.getCenter().y;
         float newCenterY = lerp(currentCenterY, targetY, 0.05f);
         carView.setCenter({viewCenterX, newCenterY});
+        cameraSettled = std::abs(newCenterY - targetY) < 0.5f; // Under a pixel of easing left
     } else {
         carView.setCenter({carView.getSize().x / 2.0f, START_Y_POSITION - window.getSize().y * 0.3f});
+        cameraSettled = true;
     }
     window.setView(carView);
 
-    road.draw(window);
-    for (const auto& obsPtr : obstacles) { if (obsPtr) obsPtr->draw(window); }
-    for (const auto& carPtr : cars) {
-        if (carPtr && carPtr.get() != focusedCar) {
-            carPtr->draw(window, false);
+    // Only what overlaps carView is submitted; everything else is culled before reaching SFML
+    const sf::FloatRect visibleArea(carView.getCenter() - carView.getSize() / 2.0f, carView.getSize());
+    road.draw(window, visibleArea);
+    renderObstacles(snapshot, visibleArea);
+    populationRenderer.draw(window, snapshot.cars, snapshot.focusedCar, visibleArea);
+    if (focusedPose) {
+        auto withinView = [&](float reach) {
+            return focusedPose->position.x + reach >= visibleArea.position.x &&
+                   focusedPose->position.x - reach <= visibleArea.position.x + visibleArea.size.x &&
+                   focusedPose->position.y + reach >= visibleArea.position.y &&
+                   focusedPose->position.y - reach <= visibleArea.position.y + visibleArea.size.y;
+        };
+        const float bodyReach = std::hypot(focusedPose->width, focusedPose->height) / 2.0f;
+        if (withinView(bodyReach)) populationRenderer.drawSingle(window, *focusedPose);
+        if (!snapshot.focusedSensor.empty() && withinView(snapshot.focusedSensorReach)) {
+            window.draw(snapshot.focusedSensor.data(), snapshot.focusedSensor.size(), sf::PrimitiveType::Lines);
         }
     }
-    if (focusedCar) {
-        focusedCar->draw(window, true);
-    }
 
 
 
+    PROFILE_SWITCH(phaseTimer, ProfilePhase::RENDER_NETWORK);
     window.setView(networkView);
 
     sf::RectangleShape networkBackground(networkView.getSize());
@@ -831,15 +1415,10 @@ void Game::renderSimulation() {
     networkBackground.setPosition({0.f, 0.f});
     window.draw(networkBackground);
 
-    NeuralNetwork* brainToDraw = nullptr;
-    if (focusedCar && focusedCar->useBrain && focusedCar->brain) {
-        brainToDraw = &(*(focusedCar->brain));
-    }
-
-    if (brainToDraw && !brainToDraw->levels.empty()) {
-        Visualizer::drawNetwork(window, *brainToDraw, font,
-                                0.f, 0.f,
-                                networkView.getSize().x, networkView.getSize().y);
+    if (snapshot.hasFocusedBrain) {
+        networkVisualizer.drawNetwork(window, *snapshot.focusedBrain, font,
+                                      0.f, 0.f,
+                                      networkView.getSize().x, networkView.getSize().y);
     } else {
         sf::Text noBrainText(font, "No brain to display", 20);
         noBrainText.setFillColor(sf::Color::White);
@@ -848,6 +1427,60 @@ void Game::renderSimulation() {
         noBrainText.setPosition({networkView.getSize().x / 2.0f, networkView.getSize().y / 2.0f});
         window.draw(noBrainText);
     }
+    if (profilerOverlayVisible) renderProfilerOverlay();
+}
+
+void Game::renderProfilerOverlay() {
+    if (profilerOverlayClock.getElapsedTime().asSeconds() >= STATUS_REFRESH_INTERVAL_SECONDS ||
+        profilerText.getString().isEmpty()) {
+        profilerOverlayClock.restart();
+        const Profiler::Recording recording = Profiler::instance().getRecording();
+        char line[96];
+        std::string text = "Profile (ms)          p50      p99\n";
+        for (size_t t = 0; t < Profiler::TRACK_COUNT; ++t) {
+            const ProfileTrack track = static_cast<ProfileTrack>(t);
+            const std::vector<Profiler::Frame>& frames = recording[t];
+            const Profiler::Stats total = Profiler::statsOf(frames, Profiler::TOTAL);
+            std::snprintf(line, sizeof(line), "%s frame (%zu)  %7.2f  %7.2f\n",
+                          track == ProfileTrack::SIMULATION ? "Simulation" : "Render", frames.size(), total.p50, total.p99);
+            text += line;
+#ifdef ENABLE_PROFILER
+            for (size_t p = 0; p < Profiler::PHASE_COUNT; ++p) {
+                const ProfilePhase phase = static_cast<ProfilePhase>(p);
+                if (Profiler::trackOf(phase) != track) continue;
+                const Profiler::Stats stats = Profiler::statsOf(frames, p);
+                std::snprintf(line, sizeof(line), "  %-20s %7.2f  %7.2f\n", Profiler::phaseName(phase), stats.p50, stats.p99);
+                text += line;
+            }
+#else
+            text += "  (phases not built: ENABLE_PROFILER is off)\n";
+#endif
+        }
+        profilerText.setString(text);
+    }
+
+    const sf::FloatRect bounds = profilerText.getLocalBounds();
+    profilerText.setPosition({10.f, 10.f});
+    profilerBackground.setPosition({5.f, 5.f});
+    profilerBackground.setSize({bounds.position.x + bounds.size.x + 10.f, bounds.position.y + bounds.size.y + 10.f});
+    profilerBackground.setFillColor(sf::Color(0, 0, 0, 180));
+    window.draw(profilerBackground);
+    window.draw(profilerText);
+}
+
+void Game::dumpProfile() {
+    char stamp[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+    std::error_code error;
+    std::filesystem::create_directories(PROFILE_DIRECTORY, error);
+    const std::string basename = PROFILE_DIRECTORY + "/profile-" + stamp;
+
+    // Copying the rings is cheap; formatting and writing happen on the persistence worker
+    auto recording = std::make_shared<const Profiler::Recording>(Profiler::instance().getRecording());
+    persistenceWorker.save(basename + ".csv", [recording] { return Profiler::toCsv(*recording); });
+    persistenceWorker.save(basename + ".json", [recording] { return Profiler::toJson(*recording); });
+    std::cout << "Profile dump queued: " << basename << ".csv/.json" << std::endl;
 }
 
 
@@ -869,9 +1502,14 @@ void Game::resetGeneration() {
     applyBrainsToGeneration(NUM_AI_CARS);
 
 
-    obstacles.clear();
-    obstacleRawPtrs.clear();
-    generateInitialObstacles(NUM_OBSTACLES, -1500.0f, -100.0f, 20.0f, 40.0f, 40.0f, 80.0f);
+    startNextCourse();
+    generationSimulatedSeconds = 0.0f;
+    simulationTimeAccumulator = 0.0f;
+    halvingRung = 0;
+    halvingActive = successiveHalvingEnabled && !loadSpecificBrainOnStart;
+    nextPruneCheckSeconds = PRUNE_CHECK_INTERVAL_SECONDS;
+    generationTicksSimulated = 0;
+    prepareGenerationEvaluation();
 
 
     manualNavigationActive = false;
@@ -889,7 +1527,60 @@ void Game::resetGeneration() {
 }
 
 
-void Game::renderGraphs() {
+void Game::renderObstacles(const WorldSnapshot& snapshot, const sf::FloatRect& visibleArea) {
+    obstaclesDrawn = 0;
+    obstaclesCulled = 0;
+    const float top = visibleArea.position.y;
+    const float bottom = visibleArea.position.y + visibleArea.size.y;
+    const std::vector<ObstaclePose>& obstaclePoses = snapshot.obstacles;
+    auto drawIfVisible = [&](const ObstaclePose& obstacle) {
+        if (obstacle.position.y + obstacle.height / 2.0f >= top &&
+            obstacle.position.y - obstacle.height / 2.0f <= bottom) {
+            Obstacle::draw(window, obstacle.position, obstacle.width, obstacle.height, obstacle.color);
+            obstaclesDrawn++;
+        } else {
+            obstaclesCulled++;
+        }
+    };
+
+    // Obstacles are stored in chunk order, so whole chunks outside the view are skipped unvisited
+    const float chunkMargin = COURSE_LAYOUT.obstacles.maxHeight;
+    size_t first = 0;
+    for (const ChunkSpan& chunk : snapshot.chunks) {
+        const size_t count = std::min(chunk.obstacleCount, obstaclePoses.size() - first);
+        if (COURSE_LAYOUT.chunkFrontY(chunk.index) - chunkMargin > bottom ||
+            COURSE_LAYOUT.chunkBackY(chunk.index) + chunkMargin < top) {
+            obstaclesCulled += count;
+            first += count;
+            continue;
+        }
+        for (size_t i = first; i < first + count; ++i) drawIfVisible(obstaclePoses[i]);
+        first += count;
+    }
+    // Obstacles that did not come from a chunk are tested one by one
+    for (size_t i = first; i < obstaclePoses.size(); ++i) drawIfVisible(obstaclePoses[i]);
+}
+
+void Game::renderGraphs(const WorldSnapshot& snapshot) {
+    if (snapshot.averageFitnessHistory.getSampleCount() < 2) return;
+    if (graphBuiltVersion != snapshot.historyVersion || graphBuiltSize != graphView.getSize()) {
+        buildGraphGeometry(snapshot);
+    }
+    window.draw(graphLines);
+    for (const sf::Text& legend : graphLegends) window.draw(legend);
+}
+
+void Game::buildGraphGeometry(const WorldSnapshot& snapshot) {
+    const HistoryStore& averageFitnessHistory = snapshot.averageFitnessHistory;
+    const HistoryStore& bestFitnessHistory = snapshot.bestFitnessHistory;
+    const HistoryStore& mutationRateHistory = snapshot.mutationRateHistory;
+    const std::vector<HistoryStore>& islandBestHistory = snapshot.islandBestHistory;
+    const HistoryStore& islandGlobalBestHistory = snapshot.islandGlobalBestHistory;
+    graphBuiltVersion = snapshot.historyVersion;
+    graphBuiltSize = graphView.getSize();
+    graphLines.clear();
+    graphLegends.clear();
+
     sf::Vector2f viewSize = graphView.getSize();
     float width = viewSize.x;
     float height = viewSize.y;
@@ -901,37 +1592,22 @@ void Game::renderGraphs() {
     float graphBottom = graphTop + graphHeight;
     float graphRight = graphLeft + graphWidth;
 
-    size_t dataCount = averageFitnessHistory.size();
-    if (dataCount < 2) return;
-
-
-    float minFit = std::numeric_limits<float>::max();
-    float maxFit = -std::numeric_limits<float>::max();
-    float minMut = std::numeric_limits<float>::max();
-    float maxMut = -std::numeric_limits<float>::max();
-
-
-    auto avgFitBegin = averageFitnessHistory.begin();
-    auto avgFitEnd = averageFitnessHistory.end();
-    auto bestFitBegin = bestFitnessHistory.begin();
-    auto bestFitEnd = bestFitnessHistory.end();
-    auto mutRateBegin = mutationRateHistory.begin();
-    auto mutRateEnd = mutationRateHistory.end();
+    const uint64_t dataCount = averageFitnessHistory.getSampleCount();
 
-    for (auto it = bestFitBegin; it != bestFitEnd; ++it) {
-        minFit = std::min(minFit, *it);
-        maxFit = std::max(maxFit, *it);
+    // Each store tracks its own extremes, so the range costs nothing however long the run
+    float minFit = std::min(bestFitnessHistory.getMin(), averageFitnessHistory.getMin());
+    float maxFit = bestFitnessHistory.getMax();
+    for (const HistoryStore& history : islandBestHistory) {
+        if (history.empty()) continue;
+        minFit = std::min(minFit, history.getMin());
+        maxFit = std::max(maxFit, history.getMax());
     }
-     for (auto it = avgFitBegin; it != avgFitEnd; ++it) {
-        minFit = std::min(minFit, *it);
-
-    }
-     for (auto it = mutRateBegin; it != mutRateEnd; ++it) {
-        minMut = std::min(minMut, *it);
-        maxMut = std::max(maxMut, *it);
+    if (!islandGlobalBestHistory.empty()) {
+        minFit = std::min(minFit, islandGlobalBestHistory.getMin());
+        maxFit = std::max(maxFit, islandGlobalBestHistory.getMax());
     }
-
-
+    float minMut = mutationRateHistory.getMin();
+    float maxMut = mutationRateHistory.getMax();
 
     if (maxFit <= minFit) maxFit = minFit + 1.0f;
     if (maxMut <= minMut) maxMut = minMut + 0.01f;
@@ -944,65 +1620,75 @@ void Game::renderGraphs() {
     };
 
 
-    sf::VertexArray axes(sf::PrimitiveType::Lines);
-    axes.append({{graphLeft, graphTop}, sf::Color(100, 100, 100)});
-    axes.append({{graphRight, graphTop}, sf::Color(100, 100, 100)});
-    axes.append({{graphLeft, graphBottom}, sf::Color(100, 100, 100)});
-    axes.append({{graphRight, graphBottom}, sf::Color(100, 100, 100)});
-    axes.append({{graphLeft, graphTop}, sf::Color(100, 100, 100)});
-    axes.append({{graphLeft, graphBottom}, sf::Color(100, 100, 100)});
-    window.draw(axes);
-
-
-    sf::VertexArray avgFitLine(sf::PrimitiveType::LineStrip);
-    sf::VertexArray bestFitLine(sf::PrimitiveType::LineStrip);
-    sf::VertexArray mutRateLine(sf::PrimitiveType::LineStrip);
-
-    for (size_t i = 0; i < dataCount; ++i) {
-        float xPos = graphLeft + (static_cast<float>(i) / static_cast<float>(dataCount - 1)) * graphWidth;
-
-        if (i < averageFitnessHistory.size()) {
-            float yPosAvg = getY(averageFitnessHistory[i], minFit, maxFit);
-            avgFitLine.append({{xPos, yPosAvg}, sf::Color::Yellow});
-        }
-        if (i < bestFitnessHistory.size()) {
-            float yPosBest = getY(bestFitnessHistory[i], minFit, maxFit);
-            bestFitLine.append({{xPos, yPosBest}, sf::Color::Cyan});
-        }
-        if (i < mutationRateHistory.size()) {
-            float yPosMut = getY(mutationRateHistory[i], minMut, maxMut);
-            mutRateLine.append({{xPos, yPosMut}, sf::Color::Magenta});
+    const sf::Color axisColor(100, 100, 100);
+    graphLines.append({{graphLeft, graphTop}, axisColor});
+    graphLines.append({{graphRight, graphTop}, axisColor});
+    graphLines.append({{graphLeft, graphBottom}, axisColor});
+    graphLines.append({{graphRight, graphBottom}, axisColor});
+    graphLines.append({{graphLeft, graphTop}, axisColor});
+    graphLines.append({{graphLeft, graphBottom}, axisColor});
+
+    // One point per bucket at its middle generation. Series that started later (the islands)
+    // are aligned to the right edge. Once buckets span several generations, their min..max
+    // range is drawn as a faint vertical band behind the line.
+    enum class Statistic { MEAN, MAX };
+    auto appendSeries = [&](const HistoryStore& history, Statistic statistic, float minValue, float maxValue,
+                            sf::Color color, bool band) {
+        const uint64_t offset = dataCount - std::min(dataCount, history.getSampleCount());
+        const uint64_t bucketWidth = history.getBucketWidth();
+        const std::vector<HistoryStore::Bucket>& buckets = history.getBuckets();
+        sf::Color bandColor = color;
+        bandColor.a = 70;
+        sf::Vector2f previous;
+        for (size_t b = 0; b < buckets.size(); ++b) {
+            const HistoryStore::Bucket& bucket = buckets[b];
+            const float sample = static_cast<float>(offset + b * bucketWidth) + static_cast<float>(bucket.count - 1) / 2.0f;
+            const float xPos = graphLeft + (sample / static_cast<float>(dataCount - 1)) * graphWidth;
+            const float value = statistic == Statistic::MAX ? bucket.max : bucket.mean();
+            const sf::Vector2f point(xPos, getY(value, minValue, maxValue));
+            if (band && bucketWidth > 1) {
+                graphLines.append({{xPos, getY(bucket.min, minValue, maxValue)}, bandColor});
+                graphLines.append({{xPos, getY(bucket.max, minValue, maxValue)}, bandColor});
+            }
+            if (b > 0) {
+                graphLines.append({previous, color});
+                graphLines.append({point, color});
+            }
+            previous = point;
         }
+    };
+    for (size_t island = 0; island < islandBestHistory.size(); ++island) {
+        const float hue = 360.0f * static_cast<float>(island) / static_cast<float>(islandBestHistory.size());
+        appendSeries(islandBestHistory[island], Statistic::MAX, minFit, maxFit, hslToRgb(hue, 0.6f, 0.35f), false);
     }
+    appendSeries(islandGlobalBestHistory, Statistic::MAX, minFit, maxFit, sf::Color::White, false);
+    appendSeries(averageFitnessHistory, Statistic::MEAN, minFit, maxFit, sf::Color::Yellow, true);
+    appendSeries(bestFitnessHistory, Statistic::MAX, minFit, maxFit, sf::Color::Cyan, true);
+    appendSeries(mutationRateHistory, Statistic::MEAN, minMut, maxMut, sf::Color::Magenta, false);
 
-    if (avgFitLine.getVertexCount() > 0) window.draw(avgFitLine);
-    if (bestFitLine.getVertexCount() > 0) window.draw(bestFitLine);
-    if (mutRateLine.getVertexCount() > 0) window.draw(mutRateLine);
 
-
-    float legendX = graphRight + 5;
-    float legendYStart = graphTop + 5;
     float legendSpacing = 15.0f;
     unsigned int legendCharSize = 10;
-
-    sf::Text avgFitLegend(font, "Avg Fitness", legendCharSize);
-    avgFitLegend.setFillColor(sf::Color::Yellow);
-    avgFitLegend.setPosition({graphLeft + 5, graphTop + 5});
-
-    sf::Text bestFitLegend(font, "Best Fitness", legendCharSize);
-    bestFitLegend.setFillColor(sf::Color::Cyan);
-    bestFitLegend.setPosition({graphLeft + 5, graphTop + 5 + legendSpacing});
-
-    sf::Text mutRateLegend(font, "Mutation Rate", legendCharSize);
-    mutRateLegend.setFillColor(sf::Color::Magenta);
-    mutRateLegend.setPosition({graphLeft + 5, graphTop + 5 + 2 * legendSpacing});
-
-    window.draw(avgFitLegend);
-    window.draw(bestFitLegend);
-    window.draw(mutRateLegend);
+    auto addLegend = [&](const std::string& label, sf::Color color) {
+        sf::Text legend(font, label, legendCharSize);
+        legend.setFillColor(color);
+        legend.setPosition({graphLeft + 5, graphTop + 5 + static_cast<float>(graphLegends.size()) * legendSpacing});
+        graphLegends.push_back(legend);
+    };
+    addLegend("Avg Fitness", sf::Color::Yellow);
+    addLegend("Best Fitness", sf::Color::Cyan);
+    addLegend("Mutation Rate", sf::Color::Magenta);
+    if (snapshot.islandModelActive) {
+        addLegend("Island Best (" + std::to_string(islandBestHistory.size()) + ") / Global Best", sf::Color::White);
+    }
+    if (averageFitnessHistory.getBucketWidth() > 1) {
+        addLegend(std::to_string(dataCount) + " gens, " + std::to_string(averageFitnessHistory.getBucketWidth()) + " per point",
+                  sf::Color(150, 150, 150));
+    }
 }
 void Game::discardSavedBrain() {
     std::cout << "Attempting to discard saved brain file(s)..." << std::endl;
+    persistenceWorker.flush(); // A queued save would otherwise bring the files back
     bool discardedDefault = false;
     bool discardedVis = false;
 
@@ -1030,6 +1716,14 @@ void Game::discardSavedBrain() {
         std::cout << "Visualization brain file not found: " << VISUALIZE_BRAIN_FILENAME << std::endl;
     }
 
+    if (std::filesystem::exists(CHECKPOINT_FILENAME)) {
+        if (std::remove(CHECKPOINT_FILENAME.c_str()) == 0) {
+            std::cout << "Discarded training checkpoint: " << CHECKPOINT_FILENAME << std::endl;
+        } else {
+            perror(("Error removing file: " + CHECKPOINT_FILENAME).c_str());
+        }
+    }
+
     if (discardedDefault || discardedVis) {
 
         if (currentState == GameState::SIMULATION && bestBrainOfGeneration) {
@@ -1037,11 +1731,113 @@ void Game::discardSavedBrain() {
             bestBrainOfGeneration = std::make_unique<NeuralNetwork>(networkStructure);
 
             applyBrainsToGeneration(NUM_AI_CARS);
+            prepareGenerationEvaluation();
         }
     }
 }
 
 
+void Game::saveCheckpoint() {
+    sf::Clock saveClock;
+    auto checkpointPtr = std::make_shared<TrainingCheckpoint>();
+    TrainingCheckpoint& checkpoint = *checkpointPtr;
+    checkpoint.generationCount = generationCount;
+    checkpoint.currentMutationRate = currentMutationRate;
+    checkpoint.courseMode = static_cast<int32_t>(courseMode);
+    checkpoint.currentScenarioId = currentScenarioId;
+    checkpoint.courseSeed = courseSeed;
+    checkpoint.scenarioBankSeed = SCENARIO_BANK_SEED;
+    checkpoint.convergenceStartGeneration = convergenceStartGeneration;
+    checkpoint.targetReachedGeneration = targetReachedGeneration;
+    checkpoint.targetReachedSeconds = targetReachedSeconds;
+    checkpoint.convergenceElapsedSeconds = convergenceSecondsBeforeResume + convergenceClock.getElapsedTime().asSeconds();
+    checkpoint.networkStructure.assign(networkStructure.begin(), networkStructure.end());
+    if (bestBrainOfGeneration) checkpoint.eliteGenome = bestBrainOfGeneration->toGenome();
+    checkpoint.populationGenomes.reserve(cars.size());
+    for (const auto& carPtr : cars) {
+        checkpoint.populationGenomes.push_back(carPtr && carPtr->brain ? carPtr->brain->toGenome() : std::vector<float>());
+    }
+    checkpoint.averageFitnessHistory = averageFitnessHistory;
+    checkpoint.bestFitnessHistory = bestFitnessHistory;
+    checkpoint.mutationRateHistory = mutationRateHistory;
+    checkpoint.rngState = getRandomState();
+
+    persistenceWorker.save(CHECKPOINT_FILENAME, [checkpointPtr]() { return checkpointPtr->serialize(); });
+    std::cout << "Checkpoint for generation " << generationCount << " queued after "
+              << saveClock.getElapsedTime().asMicroseconds() << " us." << std::endl;
+}
+
+bool Game::resumeFromCheckpoint() {
+    sf::Clock loadClock;
+    TrainingCheckpoint checkpoint;
+    if (!checkpoint.loadFromFile(CHECKPOINT_FILENAME)) {
+        return false;
+    }
+
+    const std::vector<int> savedStructure(checkpoint.networkStructure.begin(), checkpoint.networkStructure.end());
+    if (savedStructure != networkStructure || checkpoint.populationGenomes.size() != cars.size()) {
+        std::cerr << "Warning: Checkpoint was made for another network or population size. Starting fresh." << std::endl;
+        return false;
+    }
+    if (checkpoint.scenarioBankSeed != SCENARIO_BANK_SEED) {
+        std::cerr << "Warning: Checkpoint used another scenario bank. Starting fresh." << std::endl;
+        return false;
+    }
+    if (checkpoint.courseMode < static_cast<int32_t>(CourseMode::RANDOM) ||
+        checkpoint.courseMode > static_cast<int32_t>(CourseMode::ROTATING_SCENARIOS)) {
+        std::cerr << "Warning: Checkpoint has an unknown course mode. Starting fresh." << std::endl;
+        return false;
+    }
+    // Validate every genome before touching any state, so a bad file cannot leave a half-restored run
+    NeuralNetwork elite(networkStructure);
+    if (!elite.fromGenome(checkpoint.eliteGenome)) {
+        std::cerr << "Warning: Checkpoint elite does not fit the network. Starting fresh." << std::endl;
+        return false;
+    }
+    for (const std::vector<float>& genome : checkpoint.populationGenomes) {
+        if (!genome.empty() && genome.size() != elite.getGenomeSize()) {
+            std::cerr << "Warning: Checkpoint population does not fit the network. Starting fresh." << std::endl;
+            return false;
+        }
+    }
+
+    *bestBrainOfGeneration = elite;
+    preparedGenomeHashes.clear(); // The restored population replaces whatever was applied
+    for (size_t i = 0; i < cars.size(); ++i) {
+        if (cars[i] && cars[i]->brain && !checkpoint.populationGenomes[i].empty()) {
+            cars[i]->brain->fromGenome(checkpoint.populationGenomes[i]);
+        }
+    }
+
+    generationCount = checkpoint.generationCount;
+    currentMutationRate = checkpoint.currentMutationRate;
+    courseMode = static_cast<CourseMode>(checkpoint.courseMode);
+    convergenceStartGeneration = checkpoint.convergenceStartGeneration;
+    targetReachedGeneration = checkpoint.targetReachedGeneration;
+    targetReachedSeconds = checkpoint.targetReachedSeconds;
+    convergenceClock.restart();
+    convergenceSecondsBeforeResume = checkpoint.convergenceElapsedSeconds;
+    averageFitnessHistory = checkpoint.averageFitnessHistory;
+    bestFitnessHistory = checkpoint.bestFitnessHistory;
+    mutationRateHistory = checkpoint.mutationRateHistory;
+    graphDataVersion++;
+    pendingRandomState = checkpoint.rngState; // Applied by simulationThreadLoop
+
+    // Drive exactly the course this generation had when it was saved
+    currentScenarioId = checkpoint.currentScenarioId;
+    if (currentScenarioId >= 0 && scenarioBank && currentScenarioId < static_cast<int>(scenarioBank->size())) {
+        const Scenario& scenario = scenarioBank->get(static_cast<uint32_t>(currentScenarioId));
+        startCourse(scenario.seed, &scenario);
+    } else {
+        currentScenarioId = -1;
+        startCourse(checkpoint.courseSeed);
+    }
+
+    std::cout << "Resumed training at generation " << generationCount << " from " << CHECKPOINT_FILENAME
+              << " in " << loadClock.getElapsedTime().asMilliseconds() << " ms." << std::endl;
+    return true;
+}
+
 void Game::togglePause() {
     if (currentState == GameState::SIMULATION) {
         isPaused = !isPaused;
@@ -1097,6 +1893,16 @@ void Game::startManualNavigation() {
 void Game::navigateManual(sf::Keyboard::Key key) {
     if (!manualNavigationActive || navigableCars.empty() || currentState != GameState::SIMULATION) return;
 
+    // Ranks change as cars overtake each other, so the list is put in Y order only when stepping
+    navigableCars.erase(std::remove_if(navigableCars.begin(), navigableCars.end(),
+                                       [this](const Car* car) { return car->isDamaged() && car != focusedCar; }),
+                        navigableCars.end());
+    std::sort(navigableCars.begin(), navigableCars.end(), [](const Car* a, const Car* b) {
+        return a->position.y < b->position.y;
+    });
+    auto focused = std::find(navigableCars.begin(), navigableCars.end(), focusedCar);
+    currentNavIndex = focused != navigableCars.end() ? static_cast<int>(std::distance(navigableCars.begin(), focused)) : 0;
+
     int numNavigable = static_cast<int>(navigableCars.size());
     if (key == sf::Keyboard::Key::N) {
         currentNavIndex = (currentNavIndex + 1) % numNavigable;
@@ -1141,175 +1947,329 @@ void Game::populateCarVector(int N, float startY) {
     std::cout << cars.size() << " AI cars generated." << std::endl;
 }
 
-void Game::generateInitialObstacles(int N, float minY, float maxY, float minW, float maxW, float minH, float maxH) {
-    obstacles.clear();
-    obstacleRawPtrs.clear();
-    obstacles.reserve(N);
-    std::cout << "Generating " << N << " initial obstacles between Y=" << minY << " and Y=" << maxY << "..." << std::endl;
-
-    const sf::Color obstacleColor = sf::Color(128, 128, 128);
-    const float minVerticalGapAdjacentLane = 60.0f;
-    const float minVerticalGapSameLane = 100.0f;
-    int obstaclesPlaced = 0;
-    int totalAttemptsOverall = 0;
-    const int maxTotalAttempts = N * 50;
-
-    while (obstaclesPlaced < N && totalAttemptsOverall < maxTotalAttempts) {
-        totalAttemptsOverall++;
-        auto newObstacle = generateSingleObstacle(
-            minY, maxY, minW, maxW, minH, maxH, obstacleColor,
-            minVerticalGapAdjacentLane, minVerticalGapSameLane, 50
-        );
-
-        if (newObstacle) {
-            obstacleRawPtrs.push_back(newObstacle.get());
-            obstacles.push_back(std::move(newObstacle));
-            obstaclesPlaced++;
-        }
+void Game::setupScenarioBank() {
+    scenarioBank = std::make_unique<ScenarioBank>(road.left, road.width, road.laneCount, COURSE_LAYOUT);
+    if (scenarioBank->loadFromFile(SCENARIO_BANK_FILENAME) && scenarioBank->size() > 0) {
+        std::cout << "Loaded " << scenarioBank->size() << " scenarios from " << SCENARIO_BANK_FILENAME << std::endl;
+        return;
     }
 
-    if (obstaclesPlaced < N) {
-        std::cerr << "Warning: Only generated " << obstaclesPlaced << "/" << N
-                << " initial obstacles due to spacing constraints or max attempts." << std::endl;
+    sf::Clock bankClock;
+    scenarioBank->generate(SCENARIO_BANK_SIZE, SCENARIO_CHUNK_COUNT, SCENARIO_BANK_SEED);
+    std::cout << "Generated " << scenarioBank->size() << " scenarios in "
+              << bankClock.getElapsedTime().asMilliseconds() << " ms." << std::endl;
+    if (!scenarioBank->saveToFile(SCENARIO_BANK_FILENAME)) {
+        std::cerr << "Warning: Could not save scenario bank to " << SCENARIO_BANK_FILENAME << std::endl;
     }
-    std::cout << obstacles.size() << " initial obstacles placed." << std::endl;
 }
-void Game::saveBestBrain() {
-    if (loadSpecificBrainOnStart) {
-        std::cout << "(Save disabled in Visualization mode)" << std::endl;
+
+void Game::startNextCourse() {
+    if (courseMode == CourseMode::RANDOM || !scenarioBank || scenarioBank->size() == 0) {
+        currentScenarioId = -1;
+        startCourse(static_cast<uint64_t>(getRandomInt(0, std::numeric_limits<int>::max())));
         return;
     }
 
-    if (bestBrainOfGeneration) {
-        std::filesystem::path filePath(DEFAULT_BRAIN_FILENAME);
-        std::filesystem::path dirPath = filePath.parent_path();
-
-
-        if (!dirPath.empty() && !std::filesystem::exists(dirPath)) {
-            try {
-                if (std::filesystem::create_directories(dirPath)) {
-                    std::cout << "Created directory: " << dirPath.string() << std::endl;
-                } else {
-                     std::cerr << "Warning: Failed to create directory (unknown reason): " << dirPath.string() << std::endl;
+    currentScenarioId = (courseMode == CourseMode::FIXED_SCENARIO)
+        ? 0
+        : static_cast<int>(scenarioBank->scenarioForGeneration(generationCount, SCENARIO_SUBSET_SIZE));
+    const Scenario& scenario = scenarioBank->get(static_cast<uint32_t>(currentScenarioId));
+    std::cout << "Using scenario " << currentScenarioId << std::endl;
+    startCourse(scenario.seed, &scenario);
+}
 
-                }
-            } catch (const std::filesystem::filesystem_error& e) {
-                std::cerr << "Error creating directory '" << dirPath.string() << "': " << e.what() << std::endl;
-                return;
-            }
-        }
+void Game::cycleCourseMode() {
+    switch (courseMode) {
+        case CourseMode::RANDOM: courseMode = CourseMode::FIXED_SCENARIO; break;
+        case CourseMode::FIXED_SCENARIO: courseMode = CourseMode::ROTATING_SCENARIOS; break;
+        case CourseMode::ROTATING_SCENARIOS: courseMode = CourseMode::RANDOM; break;
+    }
 
+    // Convergence is measured per mode, starting from the next generation
+    convergenceClock.restart();
+    convergenceSecondsBeforeResume = 0.0f;
+    convergenceStartGeneration = generationCount + 1;
+    targetReachedGeneration = -1;
+    std::cout << "Course mode changed (applies from next generation); convergence tracking restarted." << std::endl;
+}
 
-        if (bestBrainOfGeneration->saveToFile(DEFAULT_BRAIN_FILENAME)) {
-            std::cout << "Saved Best Generation Brain to " << DEFAULT_BRAIN_FILENAME << std::endl;
-        } else {
-            std::cerr << "Error saving brain to " << DEFAULT_BRAIN_FILENAME << std::endl;
-        }
-    } else {
-        std::cerr << "No best brain available to save." << std::endl;
+void Game::cycleCrossoverMode() {
+    switch (selectionSettings.crossover) {
+        case CrossoverMode::NONE:       selectionSettings = multiParentSelection(CrossoverMode::UNIFORM); break;
+        case CrossoverMode::UNIFORM:    selectionSettings = multiParentSelection(CrossoverMode::LAYER_WISE); break;
+        case CrossoverMode::LAYER_WISE: selectionSettings = SelectionSettings{}; break;
     }
+    std::cout << "Selection: " << getSelectionName() << " (applies to the next generation)." << std::endl;
 }
 
+std::string Game::getSelectionName() const {
+    switch (selectionSettings.crossover) {
+        case CrossoverMode::UNIFORM:    return "top-16 tournament, uniform crossover";
+        case CrossoverMode::LAYER_WISE: return "top-16 tournament, layer crossover";
+        default:                        return "elite clones";
+    }
+}
 
-std::unique_ptr<Obstacle> Game::generateSingleObstacle(
-    float minY, float maxY,
-    float minW, float maxW, float minH, float maxH,
-    const sf::Color& color,
-    float minVerticalGapAdjacentLane, float minVerticalGapSameLane,
-    int maxPlacementRetries)
-{
-
-    int attempts = 0;
-    while (attempts < maxPlacementRetries) {
-        attempts++;
+void Game::captureMatingPool() {
+    matingPool.clear();
+    matingPoolFitness.clear();
+    if (selectionSettings.matingPoolSize <= 1 || !bestBrainOfGeneration) return;
 
-        int potentialLaneIndex = getRandomInt(0, road.laneCount - 1);
-        float potentialYPos = getRandomFloat(minY, maxY);
-        float potentialWidth = getRandomFloat(minW, maxW);
-        float potentialHeight = getRandomFloat(minH, maxH);
+    // Robust scores when this generation has them, otherwise the on-screen ones
+    std::vector<float> carFitness(cars.size(), -std::numeric_limits<float>::infinity());
+    for (size_t i = 0; i < cars.size(); ++i) {
+        if (!cars[i] || !cars[i]->brain) continue;
+        carFitness[i] = robustCarFitness.size() == cars.size() ? robustCarFitness[i] : cars[i]->getFitness();
+    }
+    collectMatingPool(*bestBrainOfGeneration, carFitness, matingPool, matingPoolFitness);
+}
 
+void Game::collectMatingPool(const NeuralNetwork& elite, const std::vector<float>& carFitness,
+                             std::vector<NeuralNetwork>& pool, std::vector<float>& poolFitness) const {
+    // The selected elite leads the pool whichever way it was chosen (robust eval, islands, cache)
+    pool.push_back(elite);
+    poolFitness.push_back(std::numeric_limits<float>::max());
+    const uint64_t eliteHash = elite.getGenomeHash();
+    for (size_t index : selectTopIndices(carFitness, static_cast<size_t>(selectionSettings.matingPoolSize))) {
+        if (!cars[index]->brain || cars[index]->brain->getGenomeHash() == eliteHash) continue;
+        pool.push_back(*cars[index]->brain);
+        poolFitness.push_back(carFitness[index]);
+    }
+}
 
-        float laneWidth = road.width / static_cast<float>(road.laneCount);
-        float laneLeft = road.left + potentialLaneIndex * laneWidth;
-        float laneRight = laneLeft + laneWidth;
+void Game::toggleRobustEvaluation() {
+    robustEvaluationEnabled = !robustEvaluationEnabled;
+    std::cout << "Robust evaluation " << (robustEvaluationEnabled ? "enabled" : "disabled")
+              << " (applies from the next generation)." << std::endl;
+}
 
+void Game::startRobustEvaluation() {
+    cancelRobustEvaluation();
+    if (!scenarioEvaluator) {
+        scenarioEvaluator = std::make_unique<ScenarioEvaluator>(road, COURSE_LAYOUT);
+        std::cout << "Scenario evaluator started with " << scenarioEvaluator->getWorkerCount() << " workers." << std::endl;
+    }
 
-        float minCenterX = laneLeft + potentialWidth / 2.0f;
-        float maxCenterX = laneRight - potentialWidth / 2.0f;
+    // The workers read copies, so the cars can keep driving (and the visualiser keep reading) their own brains
+    robustGenomes.clear();
+    robustGenomeOfCar.assign(cars.size(), -1);
+    for (size_t i = 0; i < cars.size(); ++i) {
+        if (!cars[i] || !cars[i]->brain) continue;
+        robustGenomeOfCar[i] = static_cast<int>(robustGenomes.size());
+        robustGenomes.push_back(*cars[i]->brain);
+    }
+    std::vector<const NeuralNetwork*> genomes;
+    genomes.reserve(robustGenomes.size());
+    for (const NeuralNetwork& genome : robustGenomes) genomes.push_back(&genome);
+    std::vector<const Scenario*> scenarios;
+    const size_t scenarioCount = std::min(scenarioBank->size(), static_cast<size_t>(ROBUST_EVAL_SCENARIOS));
+    for (size_t i = 0; i < scenarioCount; ++i) scenarios.push_back(&scenarioBank->get(static_cast<uint32_t>(i)));
+
+    robustEvaluationClock.restart();
+    robustTicksAtStart = scenarioEvaluator->getTicksSimulated();
+    robustEvaluation = std::async(std::launch::async, [this, genomes, scenarios]() {
+        return scenarioEvaluator->evaluate(genomes, scenarios, SIMULATION_TIME_LIMIT_SECONDS,
+                                           ROBUST_EVAL_AGGREGATION, ROBUST_EVAL_QUANTILE, &robustEvaluationCancelled);
+    });
+}
 
-        float potentialXPos;
-        if (maxCenterX <= minCenterX) {
+void Game::cancelRobustEvaluation() {
+    if (!robustEvaluation.valid()) return;
+    robustEvaluationCancelled = true;
+    robustEvaluation.wait();
+    robustEvaluation = std::future<std::vector<float>>();
+    robustEvaluationCancelled = false;
+}
 
-            potentialXPos = road.getLaneCenter(potentialLaneIndex);
-        } else {
+bool Game::robustEvaluationPending() const {
+    return robustEvaluation.valid() &&
+           robustEvaluation.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
 
-            potentialXPos = getRandomFloat(minCenterX, maxCenterX);
+Car* Game::selectRobustElite() {
+    robustCarFitness.clear();
+    if (!robustEvaluation.valid()) return nullptr;
+    const std::vector<float> genomeFitness = robustEvaluation.get();
+    const float elapsedMs = robustEvaluationClock.getElapsedTime().asSeconds() * 1000.0f;
+    const long long ticks = scenarioEvaluator->getTicksSimulated() - robustTicksAtStart;
+
+    robustCarFitness.assign(cars.size(), -std::numeric_limits<float>::infinity());
+    Car* best = nullptr;
+    float bestFitness = -std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < cars.size() && i < robustGenomeOfCar.size(); ++i) {
+        const int genome = robustGenomeOfCar[i];
+        if (genome < 0 || static_cast<size_t>(genome) >= genomeFitness.size()) continue;
+        robustCarFitness[i] = genomeFitness[genome];
+        if (!best || robustCarFitness[i] > bestFitness) {
+            best = cars[i].get();
+            bestFitness = robustCarFitness[i];
         }
+    }
+    if (!best) return nullptr;
 
+    int onScreenRank = 1;
+    for (const auto& carPtr : cars) {
+        if (carPtr && carPtr->getFitness() > best->getFitness()) onScreenRank++;
+    }
+    std::cout << "Robust evaluation: " << robustGenomes.size() << " genomes x "
+              << std::min(scenarioBank->size(), static_cast<size_t>(ROBUST_EVAL_SCENARIOS)) << " scenarios in "
+              << elapsedMs << " ms on " << scenarioEvaluator->getWorkerCount() << " workers (" << ticks
+              << " ticks; selection waited " << std::max(0.0f, elapsedMs - generationOnScreenMs)
+              << " ms after the cars stopped). Elite was rank " << onScreenRank
+              << " on-screen, aggregated fitness " << bestFitness << std::endl;
+    return best;
+}
 
+void Game::toggleIslandModel() {
+    if (islandModel) {
+        islandModel.reset();
+        islandBestHistory.clear();
+        islandGlobalBestHistory.clear();
+        graphDataVersion++;
+        std::cout << "Island model stopped; training continues with the single population." << std::endl;
+    } else {
+        if (loadSpecificBrainOnStart || !scenarioBank || scenarioBank->size() == 0 || !bestBrainOfGeneration) {
+            std::cout << "Island model needs training mode and a scenario bank." << std::endl;
+            return;
+        }
+        islandModel = std::make_unique<IslandModel>(road, COURSE_LAYOUT, *scenarioBank, *bestBrainOfGeneration, ISLAND_SETTINGS);
+        islandJudgedElite.reset();
+        islandBestHistory.assign(islandModel->getIslandCount(), HistoryStore());
+        graphDataVersion++;
+    }
 
-        float potentialTop = potentialYPos - potentialHeight / 2.0f;
-        float potentialBottom = potentialYPos + potentialHeight / 2.0f;
-
-
-        bool collisionFound = false;
-        for (const auto& existingObsPtr : obstacles) {
-            if (!existingObsPtr) continue;
-
-
-            float existingXPos = existingObsPtr->position.x;
-            float existingYPos = existingObsPtr->position.y;
-            float existingHeight = existingObsPtr->height;
-            float existingTop = existingYPos - existingHeight / 2.0f;
-            float existingBottom = existingYPos + existingHeight / 2.0f;
-
-
-            int existingLaneIndex = -1;
-            float minLaneDist = std::numeric_limits<float>::max();
-            for (int l = 0; l < road.laneCount; ++l) {
-                float dist = std::abs(existingXPos - road.getLaneCenter(l));
-                if (dist < (laneWidth / 2.0f) && dist < minLaneDist) {
-                    minLaneDist = dist;
-                    existingLaneIndex = l;
-                }
-            }
+    // Time-to-target is compared between the two schemes, so start measuring afresh
+    convergenceClock.restart();
+    convergenceSecondsBeforeResume = 0.0f;
+    convergenceStartGeneration = generationCount + 1;
+    targetReachedGeneration = -1;
+}
 
+bool Game::adoptIslandChampion() {
+    if (!islandModel || !bestBrainOfGeneration) return false;
+    NeuralNetwork judged = *bestBrainOfGeneration;
+    float judgedFitness = 0.0f;
+    if (islandModel->takeCommonSetScore(judged, judgedFitness)) {
+        islandJudgedElite = judged;
+        islandJudgedEliteFitness = judgedFitness;
+    }
+    const bool eliteJudged = islandJudgedElite && islandJudgedElite->getGenomeHash() == bestBrainOfGeneration->getGenomeHash() &&
+                             islandJudgedElite->sameGenome(*bestBrainOfGeneration);
+    if (!eliteJudged) {
+        // Up to 4 full runs: scored off this thread, and decided at a later boundary if this is still the elite
+        islandModel->requestCommonSetScore(*bestBrainOfGeneration);
+        return false;
+    }
 
-            float requiredVerticalGap = 0.0f;
-            if (potentialLaneIndex == existingLaneIndex && existingLaneIndex != -1) {
-                requiredVerticalGap = minVerticalGapSameLane;
-            } else if (existingLaneIndex != -1 && std::abs(potentialLaneIndex - existingLaneIndex) == 1) {
-                requiredVerticalGap = minVerticalGapAdjacentLane;
-            }
+    NeuralNetwork champion = *bestBrainOfGeneration;
+    float championFitness = 0.0f;
+    if (!islandModel->copyGlobalBest(champion, championFitness)) return false;
+    if (champion.sameGenome(*bestBrainOfGeneration)) return false;
+    if (championFitness <= islandJudgedEliteFitness) {
+        std::cout << "Kept elite over island champion (common scenarios: " << islandJudgedEliteFitness
+                  << " vs " << championFitness << ")" << std::endl;
+        return false;
+    }
 
+    std::cout << "Adopted island champion (common scenarios: " << championFitness << " vs elite "
+              << islandJudgedEliteFitness << ", migrations so far: " << islandModel->getMigrationCount() << ")" << std::endl;
+    *bestBrainOfGeneration = champion;
+    islandJudgedElite = champion;
+    islandJudgedEliteFitness = championFitness;
+    for (size_t i = 0; i < islandModel->getIslandCount(); ++i) {
+        std::cout << "  Island " << i << ": gen " << islandModel->getIslandGeneration(i)
+                  << ", mut " << islandModel->getIslandMutationRate(i)
+                  << ", best " << islandModel->getIslandBestFitness(i) << std::endl;
+    }
+    return true;
+}
 
-            bool verticalOverlapWithGap = (potentialTop - requiredVerticalGap < existingBottom) &&
-                                        (potentialBottom + requiredVerticalGap > existingTop);
+void Game::updateIslandGraphData() {
+    if (!islandModel) return;
 
+    for (size_t i = 0; i < islandBestHistory.size(); ++i) {
+        const float best = islandModel->getIslandBestFitness(i);
+        islandBestHistory[i].push(std::isfinite(best) ? best : 0.0f);
+    }
+    const float globalBest = islandModel->getGlobalBestFitness();
+    islandGlobalBestHistory.push(std::isfinite(globalBest) ? globalBest : 0.0f);
+    graphDataVersion++;
+}
 
-            bool directVerticalOverlap = potentialTop < existingBottom && potentialBottom > existingTop;
+void Game::trackConvergence(float bestFitness) {
+    if (loadSpecificBrainOnStart || targetReachedGeneration != -1 || bestFitness < TARGET_FITNESS) return;
+
+    targetReachedGeneration = generationCount;
+    targetReachedSeconds = convergenceSecondsBeforeResume + convergenceClock.getElapsedTime().asSeconds();
+    std::cout << "Target fitness " << TARGET_FITNESS << " reached after "
+              << (targetReachedGeneration - convergenceStartGeneration + 1) << " generations ("
+              << targetReachedSeconds << " s) with course mode "
+              << (courseMode == CourseMode::RANDOM ? "random" :
+                  courseMode == CourseMode::FIXED_SCENARIO ? "fixed scenario" : "rotating scenarios")
+              << "." << std::endl;
+}
 
+void Game::startCourse(uint64_t seed, const Scenario* scenario) {
+    obstacles.clear();
+    obstacleRawPtrs.clear();
+    while (!liveChunks.empty()) {
+        obstacleStreamer->recycle(std::move(liveChunks.front()));
+        liveChunks.pop_front();
+    }
 
-            if ((directVerticalOverlap && potentialLaneIndex == existingLaneIndex && existingLaneIndex != -1) ||
-                (verticalOverlapWithGap && requiredVerticalGap > 0.0f))
-            {
-                collisionFound = true;
-                break;
-            }
-        }
+    courseSeed = seed;
+    nextChunkToSpawn = 0;
+    obstacleStreamer->restart(courseSeed, OBSTACLE_CHUNK_LOOKAHEAD + 2, scenario);
+    std::cout << "Course seed: " << courseSeed << std::endl;
 
+    spawnChunksUpTo(OBSTACLE_CHUNK_LOOKAHEAD);
+}
 
-        if (!collisionFound) {
-            return std::make_unique<Obstacle>(potentialXPos, potentialYPos, potentialWidth, potentialHeight, color);
+void Game::spawnChunksUpTo(long long chunkIndex) {
+    // Which chunks are on the road depends only on the leader's position, never on how fast the
+    // worker was, so a genome drives the same course every time and cached fitness stays valid.
+    // One chunk more is requested than needed, so the worker is usually ahead and the step does not wait.
+    obstacleStreamer->requestUpTo(chunkIndex + 1);
+    ObstacleChunk chunk;
+    while (nextChunkToSpawn <= chunkIndex) {
+        if (!obstacleStreamer->waitForChunk(chunk)) return; // Streamer shutting down
+        for (const ObstacleSpec& spec : chunk.specs) {
+            spawnObstacle(spec);
         }
+        nextChunkToSpawn = chunk.index + 1;
+        liveChunks.push_back(std::move(chunk));
+    }
+}
 
+void Game::spawnObstacle(const ObstacleSpec& spec) {
+    auto newObstacle = std::make_unique<Obstacle>(spec.x, spec.y, spec.width, spec.height,
+                                                  sf::Color(128, 128, 128), spec.lane);
+    obstacleRawPtrs.push_back(newObstacle.get());
+    obstacles.push_back(std::move(newObstacle));
+}
 
+void Game::saveBestBrain() {
+    if (loadSpecificBrainOnStart) {
+        std::cout << "(Save disabled in Visualization mode)" << std::endl;
+        return;
     }
 
-
-    return nullptr;
+    if (bestBrainOfGeneration) {
+        // Snapshot now, serialise and write on the persistence thread
+        sf::Clock queueClock;
+        auto snapshot = std::make_shared<const NeuralNetwork>(*bestBrainOfGeneration);
+        persistenceWorker.save(DEFAULT_BRAIN_FILENAME, [snapshot]() {
+            std::ostringstream stream(std::ios::binary);
+            snapshot->saveToStream(stream);
+            return stream.str();
+        });
+        lastSaveQueueMicroseconds = queueClock.getElapsedTime().asMicroseconds();
+    } else {
+        std::cerr << "No best brain available to save." << std::endl;
+    }
 }
 
+
 void Game::applyBrainsToGeneration(int N) {
     if (cars.empty() || !bestBrainOfGeneration) {
         std::cerr << "Error in applyBrainsToGeneration: No cars or no base brain available." << std::endl;
@@ -1345,6 +2305,39 @@ void Game::applyBrainsToGeneration(int N) {
         }
 
 
+        const bool multiParent = matingPool.size() > 1;
+        preparedOffspringUsed =
+            (multiParent ? generationPreparer.takeBred(matingPool, currentMutationRate, selectionSettings, preparedOffspring, preparedGenomeHashes)
+                         : generationPreparer.take(*bestBrainOfGeneration, currentMutationRate, preparedOffspring, preparedGenomeHashes)) &&
+            preparedOffspring.size() + 1 == cars.size();
+        if (multiParent && !preparedOffspringUsed) {
+            // Multi-parent generation: bred into spare storage, then swapped into the cars
+            bredOffspring.resize(cars.size(), *bestBrainOfGeneration);
+            breedGeneration(matingPool, matingPoolFitness, currentMutationRate, selectionSettings, bredOffspring);
+            for (size_t i = 1; i < cars.size(); ++i) {
+                if (cars[i] && cars[i]->useBrain && cars[i]->brain) std::swap(*(cars[i]->brain), bredOffspring[i]);
+            }
+            matingPool.clear();
+            preparedGenomeHashes.clear();
+            return;
+        }
+        matingPool.clear();
+        if (preparedOffspringUsed) {
+            // Swapping hands over each offspring's weight storage without copying it
+            for (size_t i = 1; i < cars.size(); ++i) {
+                if (!cars[i] || !cars[i]->useBrain) continue;
+                if (!cars[i]->brain) {
+                    cars[i]->brain.emplace(std::move(preparedOffspring[i - 1]));
+                } else {
+                    std::swap(*(cars[i]->brain), preparedOffspring[i - 1]);
+                }
+            }
+            preparedGenomeHashes.insert(preparedGenomeHashes.begin(), bestBrainOfGeneration->getGenomeHash());
+            return;
+        }
+        preparedGenomeHashes.clear();
+
+
         for (int i = 1; i < cars.size(); ++i) {
             if (cars[i] && cars[i]->useBrain) {
                 if (!cars[i]->brain) {
@@ -1364,46 +2357,37 @@ void Game::applyBrainsToGeneration(int N) {
 void Game::manageInfiniteObstacles() {
     bestCarVisual = nullptr;
     float minY_visual = std::numeric_limits<float>::max();
+    float rearY = -std::numeric_limits<float>::max();
     for (const auto& carPtr : cars) {
         if (carPtr && !carPtr->isDamaged()) {
             if (carPtr->position.y < minY_visual) {
                 minY_visual = carPtr->position.y;
                 bestCarVisual = carPtr.get();
             }
+            rearY = std::max(rearY, carPtr->position.y);
         }
     }
 
     if (!bestCarVisual) return;
 
-    const float generationMinY = bestCarVisual->position.y + GENERATION_ZONE_END_Y;
-    const float generationMaxY = bestCarVisual->position.y + GENERATION_ZONE_START_Y;
-    const float removalY = bestCarVisual->position.y + OBSTACLE_REMOVAL_DISTANCE;
-
-    auto new_end = std::remove_if(obstacles.begin(), obstacles.end(),
-        [&](const std::unique_ptr<Obstacle>& obsPtr) {
-            if (!obsPtr) return true;
-            return obsPtr->position.y > removalY;
-        });
-    obstacles.erase(new_end, obstacles.end());
+    spawnChunksUpTo(COURSE_LAYOUT.chunkIndexAt(bestCarVisual->position.y) + OBSTACLE_CHUNK_LOOKAHEAD);
 
-    obstacleRawPtrs.clear();
-    obstacleRawPtrs.reserve(obstacles.size());
-    for (const auto& obsPtr : obstacles) {
-        if(obsPtr) obstacleRawPtrs.push_back(obsPtr.get());
+    // Obstacles are stored in chunk order, so retiring chunks trims the front of the vector
+    size_t retiredObstacles = 0;
+    while (!liveChunks.empty() &&
+           COURSE_LAYOUT.chunkFrontY(liveChunks.front().index) > rearY + CHUNK_RECYCLE_MARGIN) {
+        retiredObstacles += liveChunks.front().specs.size();
+        obstacleStreamer->recycle(std::move(liveChunks.front()));
+        liveChunks.pop_front();
     }
 
-    while (obstacles.size() < NUM_OBSTACLES) {
-        const float minW = 20.0f, maxW = 40.0f, minH = 40.0f, maxH = 80.0f;
-        const sf::Color obsColor = sf::Color(128, 128, 128);
-        const float minGapAdj = 75.0f, minGapSame = 150.0f;
-
-        auto newObstacle = generateSingleObstacle(generationMinY, generationMaxY, minW, maxW, minH, maxH, obsColor, minGapAdj, minGapSame);
-
-        if (newObstacle) {
-            obstacleRawPtrs.push_back(newObstacle.get());
-            obstacles.push_back(std::move(newObstacle));
-        } else {
-            break;
+    if (retiredObstacles > 0) {
+        retiredObstacles = std::min(retiredObstacles, obstacles.size());
+        obstacles.erase(obstacles.begin(), obstacles.begin() + retiredObstacles);
+        obstacleRawPtrs.clear();
+        obstacleRawPtrs.reserve(obstacles.size());
+        for (const auto& obsPtr : obstacles) {
+            obstacleRawPtrs.push_back(obsPtr.get());
         }
     }
 }
@@ -1422,17 +2406,9 @@ void Game::updateFocus() {
             stopManualNavigation();
             focusedCar = bestCarVisual;
         } else {
+            // navigableCars is cleared whenever the cars are rebuilt, so the pointer itself is valid
             Car* potentialFocus = navigableCars[currentNavIndex];
-            bool stillValid = false;
-
-            for(const auto& carPtr : cars) {
-                if(carPtr.get() == potentialFocus && !potentialFocus->isDamaged()) {
-                    stillValid = true;
-                    break;
-                }
-            }
-
-            if (stillValid) {
+            if (!potentialFocus->isDamaged()) {
                 focusedCar = potentialFocus;
             } else {
 
@@ -1460,81 +2436,184 @@ void Game::updateFocus() {
 
 
 void Game::updateStatusPanel() {
-    std::ostringstream statusStream;
-    statusStream << std::fixed << std::setprecision(1);
+    if (!statusPanelDirty && statusRefreshClock.getElapsedTime().asSeconds() < STATUS_REFRESH_INTERVAL_SECONDS) {
+        return;
+    }
+    statusPanelDirty = false;
+    statusRefreshClock.restart();
+
+    auto fixed = [](float value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.1f", value);
+        return std::string(buffer);
+    };
+    std::string status;
+    status.reserve(statusString.size() + 64);
 
 
     switch (currentState) {
         case GameState::MENU:
-            statusStream << "State: MENU\n";
-            statusStream << "-------------\n";
-            statusStream << "Select an option using\n";
-            statusStream << "UP/DOWN arrows and ENTER.\n\n";
-            statusStream << "ESC to exit.";
+            status += "State: MENU\n";
+            status += "-------------\n";
+            status += "Select an option using\n";
+            status += "UP/DOWN arrows and ENTER.\n\n";
+            status += "ESC to exit.";
             break;
 
         case GameState::HELP:
-            statusStream << "State: HELP\n";
-            statusStream << "-------------\n";
-            statusStream << "Displaying help image.\n\n";
-            statusStream << "Press ESC or ENTER\n";
-            statusStream << "to return to the menu.";
+            status += "State: HELP\n";
+            status += "-------------\n";
+            status += "Displaying help image.\n\n";
+            status += "Press ESC or ENTER\n";
+            status += "to return to the menu.";
             break;
 
         case GameState::SIMULATION:
             {
-                statusStream << "State: SIMULATION\n";
-                statusStream << "Mode: " << (loadSpecificBrainOnStart ? "Visualization" : "Training") << "\n";
-                statusStream << "-------------\n";
-
-                int nonDamagedCount = 0;
-                for (const auto& carPtr : cars) {
-                    if (carPtr && !carPtr->isDamaged()) {
-                        nonDamagedCount++;
-                    }
+                status += "State: SIMULATION\n";
+                status += std::string("Mode: ") + (loadSpecificBrainOnStart ? "Visualization" : "Training") + "\n";
+                status += "-------------\n";
+
+                status += "Generation: " + std::to_string(generationCount) + "\n";
+                status += "Time: " + fixed(generationSimulatedSeconds) + "s (simulated)\n";
+                status += "Sim: " + std::to_string(static_cast<int>(stepsPerSecond)) + " steps/s (" +
+                          fixed(stepsPerSecond * SIMULATION_TIME_STEP) + "x real time)\n";
+                status += isPaused ? "\n--- PAUSED ---\n\n" : "\n";
+                status += "Alive: " + std::to_string(aliveAgentCount) + " / " + std::to_string(cars.size()) + "\n";
+                status += "Simulated: " + std::to_string(aliveCarCount);
+                if (focusedCar && focusedCar->getMultiplicity() > 1) {
+                    status += " (focus x" + std::to_string(focusedCar->getMultiplicity()) + ")";
+                }
+                status += "\n";
+                status += "Obstacles: " + std::to_string(obstacles.size()) + "\n";
+                if (currentScenarioId >= 0) {
+                    status += "Course: Scenario " + std::to_string(currentScenarioId) +
+                              (courseMode == CourseMode::FIXED_SCENARIO ? " (fixed)\n" : " (rotating)\n");
+                } else {
+                    status += "Course: Random\n";
+                }
+                status += "Elite Eval: " + (robustEvaluationActive
+                              ? "all genomes on " + std::to_string(std::min(static_cast<int>(scenarioBank->size()), ROBUST_EVAL_SCENARIOS)) +
+                                    (pendingGenerationEnd != GenerationEnd::NONE ? " scenarios (waiting)\n" : " scenarios\n")
+                              : std::string("this course\n"));
+                if (!loadSpecificBrainOnStart) {
+                    status += "Selection: " + getSelectionName() + "\n";
+                    status += std::string("Halving: ") + (successiveHalvingEnabled ? "on" : "off") +
+                              ", last gen " + std::to_string(lastGenerationTicks / 1000) + "k ticks\n";
+                    status += "Pruned: " + std::to_string(prunedThisGeneration) + " this gen\n";
+                    status += "Boundary: " + std::to_string(static_cast<int>(lastBoundaryMs)) + "ms (max " +
+                              std::to_string(static_cast<int>(maxBoundaryMs)) + "), prepared " +
+                              std::to_string(generationPreparer.getHits()) + "/" +
+                              std::to_string(generationPreparer.getHits() + generationPreparer.getMisses()) + "\n";
+                }
+                status += "Fitness Cache: " + std::to_string(fitnessCache.getHits()) + " hits, " +
+                          std::to_string(fitnessCache.size()) + " entries\n";
+                if (persistenceWorker.getWritesCompleted() > 0) {
+                    status += "Save: queue " + std::to_string(lastSaveQueueMicroseconds) + "us, disk " +
+                              std::to_string(static_cast<int>(persistenceWorker.getLastWriteMs())) + "ms (max " +
+                              std::to_string(static_cast<int>(persistenceWorker.getMaxWriteMs())) + ")\n";
+                }
+                if (islandModel) {
+                    const float islandBest = islandModel->getGlobalBestFitness();
+                    status += "Islands: " + std::to_string(islandModel->getIslandCount()) + " (best " +
+                              std::to_string(std::isfinite(islandBest) ? static_cast<int>(islandBest) : 0) + ")\n";
+                }
+                if (targetReachedGeneration != -1) {
+                    status += "Target " + fixed(TARGET_FITNESS) + ": " +
+                              std::to_string(targetReachedGeneration - convergenceStartGeneration + 1) + " gens, " +
+                              fixed(targetReachedSeconds) + "s\n\n";
+                } else {
+                    status += "Target " + fixed(TARGET_FITNESS) + ": not reached\n\n";
                 }
-
-                statusStream << "Generation: " << generationCount << "\n";
-                statusStream << "Time: " << generationClock.getElapsedTime().asSeconds() << "s\n";
-                if (isPaused) { statusStream << "\n--- PAUSED ---\n\n"; } else { statusStream << "\n"; }
-                statusStream << "Alive: " << nonDamagedCount << " / " << cars.size() << "\n";
-                statusStream << "Obstacles: " << obstacles.size() << "\n\n";
 
                 if (manualNavigationActive && !navigableCars.empty() && focusedCar) {
-                    int currentRank = -1;
-
-                    std::sort(navigableCars.begin(), navigableCars.end(), [](const Car* a, const Car* b) {
-                        return a->position.y < b->position.y;
-                    });
-                    auto it = std::find(navigableCars.begin(), navigableCars.end(), focusedCar);
-                    if (it != navigableCars.end()) {
-                        currentRank = static_cast<int>(std::distance(navigableCars.begin(), it)) + 1;
-                    }
-                    statusStream << "Manual Nav: ON (Rank "
-                                << (currentRank != -1 ? std::to_string(currentRank) : "?")
-                                << "/" << navigableCars.size() << ")\n";
-                    statusStream << "Focus Y Pos: " << focusedCar->position.y << "\n";
-                    statusStream << "Focus Speed: " << focusedCar->getSpeed() << "\n";
+                    int rankedCount = 0;
+                    const int currentRank = getFocusRank(rankedCount);
+                    status += "Manual Nav: ON (Rank " + (currentRank > 0 ? std::to_string(currentRank) : std::string("?")) +
+                              "/" + std::to_string(rankedCount) + ")\n";
+                    status += "Focus Y Pos: " + fixed(focusedCar->position.y) + "\n";
+                    status += "Focus Speed: " + fixed(focusedCar->getSpeed()) + "\n";
 
                 } else if (focusedCar){
-                    statusStream << "Manual Nav: OFF\n";
-                    statusStream << "Focus Y Pos: " << focusedCar->position.y << "\n";
-                    statusStream << "Focus Speed: " << focusedCar->getSpeed() << "\n";
+                    status += "Manual Nav: OFF\n";
+                    status += "Focus Y Pos: " + fixed(focusedCar->position.y) + "\n";
+                    status += "Focus Speed: " + fixed(focusedCar->getSpeed()) + "\n";
 
                 } else {
-                    statusStream << "Manual Nav: OFF\nFocus: N/A\n";
+                    status += "Manual Nav: OFF\nFocus: N/A\n";
                 }
-
-                statusStream << "\n--- Controls ---\n";
-                statusStream << " P: Pause | R: Reset Gen\n";
-                statusStream << " N/B: Navigate Focus\n";
-                statusStream << " Enter: Stop Navigate\n";
-                statusStream << " Ctrl+S: Save Brain\n";
-                statusStream << " D: Discard Brain(s)\n";
-                statusStream << " ESC: Back to Menu";
             }
             break;
     }
 
-    statusText.setString(statusStream.str());
+    if (status != statusString) {
+        statusString.swap(status);
+        statusVersion++;
+    }
+}
+
+void Game::updateDisplayedStatus(const WorldSnapshot& snapshot) {
+    framesSinceRateUpdate++;
+    if (frameRateClock.getElapsedTime().asSeconds() >= 1.0f) {
+        framesPerSecond = static_cast<float>(framesSinceRateUpdate) / frameRateClock.restart().asSeconds();
+        worstFrameMs = worstFrameSecondsSinceRateUpdate * 1000.0f;
+        framesSinceRateUpdate = 0;
+        worstFrameSecondsSinceRateUpdate = 0.0f;
+    }
+    // New simulation text is shown at once (it is already rate-capped); the drawing stats wait for the cap
+    if (snapshot.statusVersion == displayedStatusVersion &&
+        displayedStatusClock.getElapsedTime().asSeconds() < STATUS_REFRESH_INTERVAL_SECONDS) {
+        return;
+    }
+    displayedStatusClock.restart();
+    displayedStatusVersion = snapshot.statusVersion;
+
+    std::string status;
+    status.reserve(displayedStatus.size() + 64);
+    status += snapshot.status;
+    status += "UI: " + std::to_string(static_cast<int>(framesPerSecond)) + " fps (worst " +
+              std::to_string(static_cast<int>(worstFrameMs)) + "ms)\n";
+    status += "Drawn: cars " + std::to_string(populationRenderer.getCarsDrawn()) + " (culled " +
+              std::to_string(populationRenderer.getCarsCulled()) + "), obstacles " +
+              std::to_string(obstaclesDrawn) + " (culled " + std::to_string(obstaclesCulled) + ")\n";
+    if (frameCapture.isActive()) {
+        status += "Recording: " + std::to_string(frameCapture.getFramesWritten()) + " frames written, " +
+                  std::to_string(frameCapture.getFramesDropped()) + " dropped, " +
+                  std::to_string(frameCapture.getFramesRepeated()) + " of them repeated\n";
+    }
+
+    status += "\n--- Controls ---\n";
+    status += " P: Pause | R: Reset Gen\n";
+    status += " N/B: Navigate Focus\n";
+    status += " C: Cycle Course Mode\n";
+    status += " E: Toggle Robust Eval\n";
+    status += " I: Toggle Island Model\n";
+    status += " H: Toggle Halving\n";
+    status += " X: Cycle Selection\n";
+    status += " Enter: Stop Navigate\n";
+    status += " Ctrl+S: Save Brain\n";
+    status += " D: Discard Brain(s)\n";
+    status += std::string(" V: ") + (frameCapture.isActive() ? "Stop Recording\n" : "Record Video\n");
+    status += " F3: Profiler | F4: Dump Profile\n";
+    status += " ESC: Back to Menu";
+
+    if (status != displayedStatus) {
+        displayedStatus.swap(status);
+        statusText.setString(displayedStatus);
+    }
+}
+
+int Game::getFocusRank(int& rankedCount) const {
+    // Rank = cars ahead + 1. Every Y changes on every step, so a tree keyed by Y would need
+    // re-keying each tick; counting at the panel's capped rate is cheaper and needs no sort.
+    rankedCount = 0;
+    int ahead = 0;
+    bool focusListed = false;
+    for (const Car* car : navigableCars) {
+        if (car == focusedCar) focusListed = true;
+        if (car->isDamaged() && car != focusedCar) continue;
+        rankedCount++;
+        if (car != focusedCar && car->position.y < focusedCar->position.y) ahead++;
+    }
+    return focusListed ? ahead + 1 : -1;
 }
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "GenerationPreparer.hpp"
+#include <chrono>
+#include <utility>
+
+namespace {
+uint64_t combinedHash(const NeuralNetwork* parents, size_t parentCount) {
+    uint64_t hash = 0;
+    for (size_t i = 0; i < parentCount; ++i) {
+        hash = (hash ^ parents[i].getGenomeHash()) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+bool sameSelection(const SelectionSettings& a, const SelectionSettings& b) {
+    return a.eliteCount == b.eliteCount && a.matingPoolSize == b.matingPoolSize && a.tournamentSize == b.tournamentSize &&
+           a.crossover == b.crossover && a.crossoverFraction == b.crossoverFraction &&
+           a.crossoverMutationScale == b.crossoverMutationScale && a.cloneMutationScale == b.cloneMutationScale;
+}
+
+bool sameParents(const std::vector<NeuralNetwork>& built, const NeuralNetwork* parents, size_t parentCount) {
+    if (built.size() != parentCount) return false;
+    for (size_t i = 0; i < parentCount; ++i) {
+        if (!built[i].sameGenome(parents[i])) return false;
+    }
+    return true;
+}
+}
+
+GenerationPreparer::GenerationPreparer()
+    : worker(&GenerationPreparer::workerLoop, this)
+{
+}
+
+GenerationPreparer::~GenerationPreparer() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+        requestSerial.fetch_add(1, std::memory_order_relaxed); // Abandon any build in progress
+    }
+    workAvailable.notify_one();
+    if (worker.joinable()) worker.join();
+}
+
+void GenerationPreparer::prepare(const NeuralNetwork& parent, float mutationRate, size_t offspringCount) {
+    request(Request{{parent}, {}, combinedHash(&parent, 1), mutationRate, SelectionSettings{}, offspringCount});
+}
+
+void GenerationPreparer::prepareBred(const std::vector<NeuralNetwork>& parents, const std::vector<float>& fitness,
+                                     float mutationRate, const SelectionSettings& selection, size_t offspringCount) {
+    if (parents.empty() || parents.size() != fitness.size()) return;
+    request(Request{parents, fitness, combinedHash(parents.data(), parents.size()), mutationRate, selection, offspringCount});
+}
+
+void GenerationPreparer::request(Request next) {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        const bool alreadyCovered =
+            (readyValid && readyParentHash == next.parentHash && readyMutationRate == next.mutationRate &&
+             sameSelection(readySelection, next.selection) && readyOffspring.size() == next.offspringCount) ||
+            (isBuilding && !pending && buildingParentHash == next.parentHash && buildingMutationRate == next.mutationRate &&
+             sameSelection(buildingSelection, next.selection));
+        if (alreadyCovered) return;
+        pending = std::move(next);
+        requestSerial.fetch_add(1, std::memory_order_relaxed);
+    }
+    workAvailable.notify_one();
+}
+
+bool GenerationPreparer::take(const NeuralNetwork& parent, float mutationRate,
+                              std::vector<NeuralNetwork>& offspring, std::vector<uint64_t>& hashes) {
+    return takeMatching(&parent, 1, mutationRate, SelectionSettings{}, offspring, hashes);
+}
+
+bool GenerationPreparer::takeBred(const std::vector<NeuralNetwork>& parents, float mutationRate, const SelectionSettings& selection,
+                                  std::vector<NeuralNetwork>& offspring, std::vector<uint64_t>& hashes) {
+    return takeMatching(parents.data(), parents.size(), mutationRate, selection, offspring, hashes);
+}
+
+bool GenerationPreparer::takeMatching(const NeuralNetwork* parents, size_t parentCount, float mutationRate,
+                                      const SelectionSettings& selection,
+                                      std::vector<NeuralNetwork>& offspring, std::vector<uint64_t>& hashes) {
+    const uint64_t parentHash = combinedHash(parents, parentCount);
+    std::unique_lock<std::mutex> lock(stateMutex);
+    auto matches = [&](uint64_t hash, float rate, const SelectionSettings& built) {
+        return hash == parentHash && rate == mutationRate && sameSelection(built, selection);
+    };
+    if (pending && matches(pending->parentHash, pending->mutationRate, pending->selection) &&
+        sameParents(pending->parents, parents, parentCount)) {
+        // Queued but not started: building it here would cost the same as the caller doing it
+        pending.reset();
+        ++misses;
+        return false;
+    }
+    if (isBuilding && !pending && matches(buildingParentHash, buildingMutationRate, buildingSelection)) {
+        buildFinished.wait(lock, [this] { return !isBuilding; });
+    }
+    if (!readyValid || !matches(readyParentHash, readyMutationRate, readySelection) ||
+        !sameParents(readyParents, parents, parentCount)) {
+        ++misses;
+        return false;
+    }
+    std::swap(offspring, readyOffspring);
+    std::swap(hashes, readyHashes);
+    readyValid = false;
+    ++hits;
+    return true;
+}
+
+void GenerationPreparer::workerLoop() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    while (true) {
+        workAvailable.wait(lock, [this] { return stopping || pending.has_value(); });
+        if (stopping) return;
+
+        Request request = std::move(*pending);
+        pending.reset();
+        const uint64_t serial = requestSerial.load(std::memory_order_relaxed);
+        isBuilding = true;
+        buildingParentHash = request.parentHash;
+        buildingMutationRate = request.mutationRate;
+        buildingSelection = request.selection;
+        readyValid = false;
+        // Reuse the previous buffer's storage
+        std::vector<NeuralNetwork> offspring = std::move(readyOffspring);
+        std::vector<uint64_t> hashes = std::move(readyHashes);
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        const NeuralNetwork& firstParent = request.parents.front();
+        bool abandoned = false;
+        if (request.parents.size() > 1) {
+            // breedGeneration fills the best parent's slot too; it is dropped afterwards
+            offspring.resize(request.offspringCount + 1, firstParent);
+            breedGeneration(request.parents, request.fitness, request.mutationRate, request.selection, offspring);
+            offspring.erase(offspring.begin());
+            abandoned = requestSerial.load(std::memory_order_relaxed) != serial;
+        } else {
+            if (offspring.size() > request.offspringCount) {
+                offspring.erase(offspring.begin() + request.offspringCount, offspring.end());
+            }
+            for (size_t i = 0; i < request.offspringCount; ++i) {
+                if (requestSerial.load(std::memory_order_relaxed) != serial) {
+                    abandoned = true;
+                    break;
+                }
+                if (i < offspring.size()) {
+                    offspring[i] = firstParent;
+                } else {
+                    offspring.push_back(firstParent);
+                }
+                NeuralNetwork::mutate(offspring[i], request.mutationRate);
+            }
+        }
+        hashes.resize(offspring.size());
+        for (size_t i = 0; i < offspring.size() && !abandoned; ++i) {
+            hashes[i] = offspring[i].getGenomeHash();
+        }
+        lastBuildMs.store(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                          std::memory_order_relaxed);
+
+        lock.lock();
+        readyOffspring = std::move(offspring);
+        readyHashes = std::move(hashes);
+        readyParentHash = request.parentHash;
+        readyParents = std::move(request.parents);
+        readyMutationRate = request.mutationRate;
+        readySelection = request.selection;
+        readyValid = !abandoned;
+        isBuilding = false;
+        buildFinished.notify_all();
+    }
+}
@@ -0,0 +1,79 @@
+#include "HeadlessWorld.hpp"
+#include "Car.hpp"
+#include "Obstacle.hpp"
+#include "Network.hpp"
+#include <algorithm>
+
+HeadlessWorld::HeadlessWorld(const Road& roadLayout, const CourseLayout& courseLayout)
+    : road(roadLayout), course(courseLayout),
+      generator(roadLayout.left, roadLayout.width, roadLayout.laneCount),
+      car(std::make_unique<Car>(roadLayout.getLaneCenter(1), START_Y_POSITION, 30.0f, 50.0f, ControlType::AI, 3.0f))
+{
+}
+
+HeadlessWorld::~HeadlessWorld() = default;
+
+float HeadlessWorld::evaluate(const NeuralNetwork& brain, const Scenario& scenario, float maxSeconds) {
+    obstacles.clear();
+    obstacleRawPtrs.clear();
+    liveChunks.clear();
+    nextChunk = 0;
+
+    car->resetForNewGeneration(START_Y_POSITION, road);
+    car->brain = brain;
+
+    const sf::Time timeStep = sf::seconds(TIME_STEP_SECONDS);
+    const long long maxTicks = static_cast<long long>(maxSeconds / TIME_STEP_SECONDS);
+    for (long long tick = 0; tick < maxTicks && !car->isDamaged(); ++tick) {
+        streamChunks(scenario);
+        car->update(road, obstacleRawPtrs, timeStep);
+        ++ticksSimulated;
+    }
+    return car->getFitness();
+}
+
+void HeadlessWorld::streamChunks(const Scenario& scenario) {
+    const long long neededChunk = course.chunkIndexAt(car->position.y) + CHUNK_LOOKAHEAD;
+    bool changed = false;
+    while (nextChunk <= neededChunk) {
+        loadChunk(scenario, nextChunk++);
+        changed = true;
+    }
+
+    size_t retired = 0;
+    while (!liveChunks.empty() &&
+           course.chunkFrontY(liveChunks.front().first) > car->position.y + CHUNK_RECYCLE_MARGIN) {
+        retired += liveChunks.front().second;
+        liveChunks.pop_front();
+    }
+    if (retired > 0) {
+        obstacles.erase(obstacles.begin(), obstacles.begin() + std::min(retired, obstacles.size()));
+        changed = true;
+    }
+
+    if (changed) rebuildRawPointers();
+}
+
+void HeadlessWorld::loadChunk(const Scenario& scenario, long long chunkIndex) {
+    // Stored chunks first, then the same seeded generation the streamer uses
+    std::vector<ObstacleSpec> generated;
+    const std::vector<ObstacleSpec>* specs = scenario.findChunk(chunkIndex);
+    if (!specs) {
+        generator.sampleChunk(scenario.seed, chunkIndex, course, generated);
+        specs = &generated;
+    }
+
+    for (const ObstacleSpec& spec : *specs) {
+        obstacles.push_back(std::make_unique<Obstacle>(spec.x, spec.y, spec.width, spec.height,
+                                                       sf::Color(128, 128, 128), spec.lane));
+    }
+    liveChunks.emplace_back(chunkIndex, specs->size());
+}
+
+void HeadlessWorld::rebuildRawPointers() {
+    obstacleRawPtrs.clear();
+    obstacleRawPtrs.reserve(obstacles.size());
+    for (const auto& obsPtr : obstacles) {
+        obstacleRawPtrs.push_back(obsPtr.get());
+    }
+}
@@ -0,0 +1,77 @@
+#include "HistoryStore.hpp"
+#include <algorithm>
+
+HistoryStore::HistoryStore(size_t maxBuckets)
+    : maxBuckets(std::max<size_t>(2, maxBuckets & ~static_cast<size_t>(1)))
+{
+    buckets.reserve(this->maxBuckets);
+}
+
+void HistoryStore::push(float value) {
+    if (sampleCount == 0) {
+        minValue = value;
+        maxValue = value;
+    } else {
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+    sampleCount++;
+
+    if (buckets.size() == maxBuckets && buckets.back().count == bucketWidth) {
+        mergePairs();
+    }
+    if (!buckets.empty() && buckets.back().count < bucketWidth) {
+        Bucket& bucket = buckets.back();
+        bucket.min = std::min(bucket.min, value);
+        bucket.max = std::max(bucket.max, value);
+        bucket.sum += value;
+        bucket.count++;
+    } else {
+        buckets.push_back({value, value, value, 1});
+    }
+}
+
+void HistoryStore::mergePairs() {
+    size_t out = 0;
+    for (size_t i = 0; i < buckets.size(); i += 2, ++out) {
+        Bucket merged = buckets[i];
+        if (i + 1 < buckets.size()) {
+            const Bucket& next = buckets[i + 1];
+            merged.min = std::min(merged.min, next.min);
+            merged.max = std::max(merged.max, next.max);
+            merged.sum += next.sum;
+            merged.count += next.count;
+        }
+        buckets[out] = merged;
+    }
+    buckets.resize(out);
+    bucketWidth *= 2;
+}
+
+void HistoryStore::clear() {
+    buckets.clear();
+    bucketWidth = 1;
+    sampleCount = 0;
+    minValue = 0.0f;
+    maxValue = 0.0f;
+}
+
+bool HistoryStore::restore(uint64_t width, const std::vector<Bucket>& saved) {
+    clear();
+    if (width == 0 || saved.size() > maxBuckets) return false;
+    uint64_t total = 0;
+    for (size_t i = 0; i < saved.size(); ++i) {
+        const bool last = i + 1 == saved.size();
+        if (saved[i].count == 0 || saved[i].count > width || (!last && saved[i].count != width)) return false;
+        total += saved[i].count;
+    }
+
+    buckets = saved;
+    bucketWidth = width;
+    sampleCount = total;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        minValue = i == 0 ? buckets[i].min : std::min(minValue, buckets[i].min);
+        maxValue = i == 0 ? buckets[i].max : std::max(maxValue, buckets[i].max);
+    }
+    return true;
+}
@@ -0,0 +1,179 @@
+#include "IslandModel.hpp"
+#include "ScenarioBank.hpp"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <chrono>
+#include <iostream>
+
+IslandModel::IslandModel(const Road& road, const CourseLayout& course, const ScenarioBank& scenarioBank,
+                         const NeuralNetwork& seedBrain, const IslandSettings& islandSettings)
+    : bank(scenarioBank), settings(islandSettings)
+{
+    int islandCount = settings.islandCount;
+    if (islandCount <= 0) {
+        islandCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    settings.populationPerIsland = std::max(2, settings.populationPerIsland);
+    judgeWorld = std::make_unique<HeadlessWorld>(road, course);
+
+    for (int i = 0; i < islandCount; ++i) {
+        auto island = std::make_unique<Island>();
+        island->index = static_cast<size_t>(i);
+        // Geometric spread: low-rate islands refine, high-rate islands explore
+        const float t = islandCount > 1 ? static_cast<float>(i) / static_cast<float>(islandCount - 1) : 0.0f;
+        island->mutationRate = settings.minMutationRate *
+                               std::pow(settings.maxMutationRate / settings.minMutationRate, t);
+        island->world = std::make_unique<HeadlessWorld>(road, course);
+        island->population.reserve(settings.populationPerIsland);
+        island->population.push_back(seedBrain);
+        for (int j = 1; j < settings.populationPerIsland; ++j) {
+            island->population.push_back(seedBrain);
+            NeuralNetwork::mutate(island->population.back(), island->mutationRate);
+        }
+        island->offspring = island->population;
+        islands.push_back(std::move(island));
+    }
+
+    // Threads start only once every island (and so every mailbox) exists
+    for (auto& island : islands) {
+        island->thread = std::thread(&IslandModel::islandLoop, this, std::ref(*island));
+    }
+    std::cout << "Island model started: " << islands.size() << " islands x "
+              << settings.populationPerIsland << " genomes, migration every "
+              << settings.migrationInterval << " generations." << std::endl;
+}
+
+IslandModel::~IslandModel() {
+    running.store(false, std::memory_order_relaxed);
+    for (auto& island : islands) {
+        if (island->thread.joinable()) island->thread.join();
+    }
+    if (judgement.valid()) judgement.wait(); // It reads judgedGenome and judgeWorld
+}
+
+float IslandModel::getIslandBestFitness(size_t island) const {
+    return islands[island]->bestFitness.load(std::memory_order_relaxed);
+}
+
+int IslandModel::getIslandGeneration(size_t island) const {
+    return islands[island]->generation.load(std::memory_order_relaxed);
+}
+
+float IslandModel::getGlobalBestFitness() const {
+    std::lock_guard<std::mutex> lock(globalBestMutex);
+    return globalBestFitness;
+}
+
+bool IslandModel::copyGlobalBest(NeuralNetwork& out, float& fitness) const {
+    std::lock_guard<std::mutex> lock(globalBestMutex);
+    if (!globalBestGenome) return false;
+    out = *globalBestGenome;
+    fitness = globalBestFitness;
+    return true;
+}
+
+void IslandModel::requestCommonSetScore(const NeuralNetwork& genome) {
+    if (judgement.valid()) return; // Busy, or a finished score not taken yet
+    judgedGenome.emplace(genome);
+    judgement = std::async(std::launch::async, [this]() { return commonSetFitness(*judgeWorld, *judgedGenome); });
+}
+
+bool IslandModel::takeCommonSetScore(NeuralNetwork& genome, float& fitness) {
+    if (!judgement.valid() || judgement.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
+    fitness = judgement.get();
+    genome = *judgedGenome;
+    return true;
+}
+
+size_t IslandModel::commonSetSize() const {
+    return std::min(bank.size(), static_cast<size_t>(std::max(1, settings.scenarioSubsetSize)));
+}
+
+float IslandModel::commonSetFitness(HeadlessWorld& world, const NeuralNetwork& genome) const {
+    const size_t count = commonSetSize();
+    if (count == 0) return -std::numeric_limits<float>::infinity();
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        sum += world.evaluate(genome, bank.get(static_cast<uint32_t>(i)), settings.maxSecondsPerRun);
+    }
+    return sum / static_cast<float>(count);
+}
+
+void IslandModel::islandLoop(Island& island) {
+    try {
+        while (running.load(std::memory_order_relaxed)) {
+            stepGeneration(island);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Island " << island.index << " stopped: " << e.what() << std::endl;
+    }
+}
+
+void IslandModel::stepGeneration(Island& island) {
+    const size_t subset = commonSetSize();
+    if (subset == 0) {
+        running.store(false, std::memory_order_relaxed);
+        return;
+    }
+    // Offset by island index so neighbouring islands are not tuned to the same course
+    const int generation = island.generation.load(std::memory_order_relaxed);
+    const Scenario& scenario = bank.get(static_cast<uint32_t>((generation + island.index) % subset));
+
+    std::vector<float> fitness(island.population.size());
+    for (size_t i = 0; i < island.population.size(); ++i) {
+        if (!running.load(std::memory_order_relaxed)) return;
+        fitness[i] = island.world->evaluate(island.population[i], scenario, settings.maxSecondsPerRun);
+    }
+
+    std::vector<size_t> ranking(fitness.size());
+    std::iota(ranking.begin(), ranking.end(), 0);
+    const size_t keep = std::min(ranking.size(), static_cast<size_t>(std::max(1, settings.migrantCount)));
+    std::partial_sort(ranking.begin(), ranking.begin() + keep, ranking.end(),
+                      [&](size_t a, size_t b) { return fitness[a] > fitness[b]; });
+
+    island.bestFitness.store(fitness[ranking[0]], std::memory_order_relaxed);
+    // This generation's scenario may simply be an easy one, so the island's best is re-scored
+    // on the common set before it can become the global best
+    offerGlobalBest(island.population[ranking[0]], commonSetFitness(*island.world, island.population[ranking[0]]));
+    island.generation.store(generation + 1, std::memory_order_relaxed);
+
+    if (islands.size() > 1 && settings.migrationInterval > 0 && (generation + 1) % settings.migrationInterval == 0) {
+        emigrate(island, ranking, fitness);
+    }
+
+    breedGeneration(island.population, fitness, island.mutationRate, settings.selection, island.offspring);
+    island.population.swap(island.offspring);
+    immigrate(island);
+}
+
+void IslandModel::emigrate(Island& island, const std::vector<size_t>& ranking, const std::vector<float>& fitness) {
+    Island& target = *islands[(island.index + 1) % islands.size()];
+    const size_t count = std::min(ranking.size(), static_cast<size_t>(std::max(0, settings.migrantCount)));
+    for (size_t i = 0; i < count; ++i) {
+        Migrant migrant;
+        migrant.fitness = fitness[ranking[i]];
+        migrant.genome.emplace(island.population[ranking[i]]);
+        if (!target.inbox.push(std::move(migrant))) break; // Receiver is behind; drop the rest
+        migrationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void IslandModel::immigrate(Island& island) {
+    // Migrants replace offspring (never the elites) unchanged and compete in the next generation
+    size_t slot = static_cast<size_t>(std::max(1, settings.selection.eliteCount));
+    Migrant migrant;
+    while (island.inbox.pop(migrant)) {
+        if (!migrant.genome) continue;
+        if (slot >= island.population.size()) continue; // Drain the mailbox even when full
+        island.population[slot++] = std::move(*migrant.genome);
+        migrant.genome.reset();
+    }
+}
+
+void IslandModel::offerGlobalBest(const NeuralNetwork& genome, float fitness) {
+    std::lock_guard<std::mutex> lock(globalBestMutex);
+    if (fitness <= globalBestFitness) return;
+    globalBestFitness = fitness;
+    globalBestGenome = genome;
+}
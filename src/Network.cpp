@@ -6,6 +6,7 @@
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include <cstring>
 
 Level::Level(int inputCount, int outputCount)
     : inputs(inputCount), outputs(outputCount), biases(outputCount), weights(inputCount, std::vector<float>(outputCount))
@@ -45,7 +46,7 @@ const std::vector<float>& Level::feedForward(const std::vector<float>& givenInpu
     return level.outputs;
 }
 
-void Level::save(std::ofstream& file) const {
+void Level::save(std::ostream& file) const {
     size_t biasCount = biases.size();
     file.write(reinterpret_cast<const char*>(&biasCount), sizeof(biasCount));
     file.write(reinterpret_cast<const char*>(biases.data()), biasCount * sizeof(float));
@@ -109,19 +110,99 @@ void NeuralNetwork::mutate(NeuralNetwork& network, float amount) {
     }
 }
 
+size_t NeuralNetwork::getGenomeSize() const {
+    size_t size = 0;
+    for (const Level& level : levels) {
+        size += level.biases.size() + level.inputs.size() * level.outputs.size();
+    }
+    return size;
+}
+
+uint64_t NeuralNetwork::getGenomeHash() const {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    for (const Level& level : levels) {
+        const uint64_t shape[2] = {level.inputs.size(), level.outputs.size()};
+        mix(shape, sizeof(shape));
+        mix(level.biases.data(), level.biases.size() * sizeof(float));
+        for (const std::vector<float>& inputWeights : level.weights) {
+            mix(inputWeights.data(), inputWeights.size() * sizeof(float));
+        }
+    }
+    return hash;
+}
+
+bool NeuralNetwork::sameGenome(const NeuralNetwork& other) const {
+    auto sameBits = [](const std::vector<float>& a, const std::vector<float>& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+    };
+    if (levels.size() != other.levels.size()) return false;
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const Level& level = levels[i];
+        const Level& otherLevel = other.levels[i];
+        if (level.inputs.size() != otherLevel.inputs.size() || !sameBits(level.biases, otherLevel.biases) ||
+            level.weights.size() != otherLevel.weights.size()) {
+            return false;
+        }
+        for (size_t j = 0; j < level.weights.size(); ++j) {
+            if (!sameBits(level.weights[j], otherLevel.weights[j])) return false;
+        }
+    }
+    return true;
+}
+
+std::vector<float> NeuralNetwork::toGenome() const {
+    std::vector<float> genome;
+    genome.reserve(getGenomeSize());
+    for (const Level& level : levels) {
+        genome.insert(genome.end(), level.biases.begin(), level.biases.end());
+        for (const std::vector<float>& inputWeights : level.weights) {
+            genome.insert(genome.end(), inputWeights.begin(), inputWeights.end());
+        }
+    }
+    return genome;
+}
+
+bool NeuralNetwork::fromGenome(const std::vector<float>& genome) {
+    return fromGenome(genome.data(), genome.size());
+}
+
+bool NeuralNetwork::fromGenome(const float* genome, size_t genomeSize) {
+    if (genomeSize != getGenomeSize()) return false;
+    for (Level& level : levels) {
+        std::copy(genome, genome + level.biases.size(), level.biases.begin());
+        genome += level.biases.size();
+        for (std::vector<float>& inputWeights : level.weights) {
+            std::copy(genome, genome + inputWeights.size(), inputWeights.begin());
+            genome += inputWeights.size();
+        }
+    }
+    return true;
+}
+
 bool NeuralNetwork::saveToFile(const std::string& filename) const {
     std::ofstream file(filename, std::ios::binary);
     if (!file.is_open()) {
         std::cerr << "Error: Could not open file for saving network: " << filename << std::endl;
         return false;
     }
+    saveToStream(file);
+    file.close();
+    return !file.fail();
+}
+
+void NeuralNetwork::saveToStream(std::ostream& stream) const {
     size_t numLevels = levels.size();
-    file.write(reinterpret_cast<const char*>(&numLevels), sizeof(numLevels));
+    stream.write(reinterpret_cast<const char*>(&numLevels), sizeof(numLevels));
     for (const auto& level : levels) {
-        level.save(file);
+        level.save(stream);
     }
-    file.close();
-    return !file.fail();
 }
 
 bool NeuralNetwork::loadFromFile(const std::string& filename) {
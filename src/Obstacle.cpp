@@ -6,37 +6,31 @@
 
 std::atomic<long long> Obstacle::nextId(0);
 
-Obstacle::Obstacle(float x, float y, float w, float h, sf::Color col)       
+Obstacle::Obstacle(float x, float y, float w, float h, sf::Color col, int laneIndex)
     : position(x, y), width(w), height(h), color(col),
       id(nextId.fetch_add(1, std::memory_order_relaxed)),
-      sprite(texture)
+      lane(laneIndex)
 {
     updatePolygon();
-    loadTexture("assets/obstacle.png");
-    if (!textureLoaded) {
-        
-    }
 }
 
 long long Obstacle::getId() const {
     return id;
 }
 
-void Obstacle::loadTexture(const std::string& filename) {
-    textureLoaded = false;
-    if (!texture.loadFromFile(filename)) return;
-    texture.setSmooth(true);
-    sprite.setTexture(texture, true);
-    sf::FloatRect textureRect = sprite.getLocalBounds();
-    if (textureRect.size.x > 0 && textureRect.size.y > 0) {
-        sprite.setScale({width / textureRect.size.x, height / textureRect.size.y});
-    } else {
-        sprite.setScale({1.0f, 1.0f});
-        return;
+const sf::Texture* Obstacle::getSharedTexture() {
+    static sf::Texture texture;
+    static bool textureLoaded = false;
+    static bool loadAttempted = false;
+    if (!loadAttempted) {
+        loadAttempted = true;
+        if (texture.loadFromFile("assets/obstacle.png")) {
+            sf::Vector2u size = texture.getSize();
+            textureLoaded = size.x > 0 && size.y > 0;
+            texture.setSmooth(true);
+        }
     }
-    sprite.setOrigin({textureRect.size.x / 2.0f, textureRect.size.y / 2.0f});
-    sprite.setColor(color);
-    textureLoaded = true;
+    return textureLoaded ? &texture : nullptr;
 }
 
 void Obstacle::updatePolygon() {
@@ -55,10 +49,18 @@ std::vector<sf::Vector2f> Obstacle::getPolygon() const {
 }
 
 void Obstacle::draw(sf::RenderTarget& target) const {
-    if (textureLoaded) {
-        sf::Sprite currentSprite = sprite;
-        currentSprite.setPosition(position);
-        target.draw(currentSprite);
+    draw(target, position, width, height, color);
+}
+
+void Obstacle::draw(sf::RenderTarget& target, sf::Vector2f position, float width, float height, sf::Color color) {
+    if (const sf::Texture* texture = getSharedTexture()) {
+        sf::Vector2u textureSize = texture->getSize();
+        sf::Sprite sprite(*texture);
+        sprite.setScale({width / textureSize.x, height / textureSize.y});
+        sprite.setOrigin({textureSize.x / 2.0f, textureSize.y / 2.0f});
+        sprite.setColor(color);
+        sprite.setPosition(position);
+        target.draw(sprite);
     } else {
         sf::RectangleShape rectShape({width, height});
         rectShape.setOrigin({width / 2.0f, height / 2.0f});
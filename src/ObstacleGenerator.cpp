@@ -0,0 +1,219 @@
+#include "ObstacleGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// --- LaneIntervalIndex ---
+
+LaneIntervalIndex::LaneIntervalIndex(int laneCount) {
+    reset(laneCount);
+}
+
+void LaneIntervalIndex::reset(int laneCount) {
+    lanes.assign(std::max(0, laneCount), {});
+    maxHalfHeights.assign(lanes.size(), 0.0f);
+}
+
+void LaneIntervalIndex::insert(int lane, float centerY, float height) {
+    if (lane < 0 || lane >= static_cast<int>(lanes.size())) return;
+    const float halfHeight = height / 2.0f;
+    lanes[lane].emplace(centerY, halfHeight);
+    maxHalfHeights[lane] = std::max(maxHalfHeights[lane], halfHeight);
+}
+
+template <typename Fn>
+bool LaneIntervalIndex::visitConflicts(int lane, float top, float bottom, float gap, Fn onConflict) const {
+    if (lane < 0 || lane >= static_cast<int>(lanes.size()) || gap <= 0.0f) return false;
+
+    // Only centers inside this window can be closer than 'gap' to the candidate
+    const auto& intervals = lanes[lane];
+    const float reach = gap + maxHalfHeights[lane];
+    bool found = false;
+    for (auto it = intervals.lower_bound(top - reach); it != intervals.end() && it->first < bottom + reach; ++it) {
+        const float existingTop = it->first - it->second;
+        const float existingBottom = it->first + it->second;
+        if (top - gap < existingBottom && bottom + gap > existingTop) {
+            found = true;
+            if (!onConflict(existingTop)) break;
+        }
+    }
+    return found;
+}
+
+bool LaneIntervalIndex::isClear(int lane, float top, float bottom, float gapSameLane, float gapAdjacentLane) const {
+    auto stop = [](float) { return false; };
+    return !visitConflicts(lane, top, bottom, gapSameLane, stop) &&
+           !visitConflicts(lane - 1, top, bottom, gapAdjacentLane, stop) &&
+           !visitConflicts(lane + 1, top, bottom, gapAdjacentLane, stop);
+}
+
+std::optional<float> LaneIntervalIndex::nextClearBottom(int lane, float top, float bottom,
+                                                        float gapSameLane, float gapAdjacentLane) const {
+    float clearBottom = std::numeric_limits<float>::max();
+    auto collect = [&](float gap) {
+        return [&clearBottom, gap](float existingTop) {
+            clearBottom = std::min(clearBottom, existingTop - gap);
+            return true;
+        };
+    };
+    bool blocked = visitConflicts(lane, top, bottom, gapSameLane, collect(gapSameLane));
+    blocked |= visitConflicts(lane - 1, top, bottom, gapAdjacentLane, collect(gapAdjacentLane));
+    blocked |= visitConflicts(lane + 1, top, bottom, gapAdjacentLane, collect(gapAdjacentLane));
+    if (!blocked) return std::nullopt;
+    return clearBottom;
+}
+
+void LaneIntervalIndex::removeBehind(float y) {
+    for (auto& intervals : lanes) {
+        intervals.erase(intervals.upper_bound(y), intervals.end());
+    }
+}
+
+size_t LaneIntervalIndex::size() const {
+    size_t total = 0;
+    for (const auto& intervals : lanes) total += intervals.size();
+    return total;
+}
+
+// --- ObstacleGenerator ---
+
+ObstacleGenerator::ObstacleGenerator(float left, float width, int lanes)
+    : roadLeft(left), roadWidth(width), laneCount(std::max(0, lanes)),
+      laneWidth(lanes > 0 ? width / static_cast<float>(lanes) : width),
+      index(lanes), rng(std::random_device{}())
+{
+}
+
+void ObstacleGenerator::seed(uint32_t value) {
+    rng.seed(value);
+}
+
+void ObstacleGenerator::clear() {
+    index.reset(laneCount);
+}
+
+void ObstacleGenerator::insert(const ObstacleSpec& spec) {
+    index.insert(spec.lane, spec.y, spec.height);
+}
+
+void ObstacleGenerator::removeBehind(float y) {
+    index.removeBehind(y);
+}
+
+float ObstacleGenerator::randomFloat(float min, float max) {
+    if (max <= min) return min;
+    std::uniform_real_distribution<float> dist(min, max);
+    return dist(rng);
+}
+
+float ObstacleGenerator::randomXInLane(int lane, float width) {
+    const float laneLeft = roadLeft + lane * laneWidth;
+    const float minCenterX = laneLeft + width / 2.0f;
+    const float maxCenterX = laneLeft + laneWidth - width / 2.0f;
+    if (maxCenterX <= minCenterX) {
+        return laneLeft + laneWidth / 2.0f;
+    }
+    return randomFloat(minCenterX, maxCenterX);
+}
+
+std::optional<ObstacleSpec> ObstacleGenerator::sampleSingle(float minY, float maxY, const ObstacleLayout& layout,
+                                                            int maxPlacementRetries) {
+    if (laneCount <= 0) return std::nullopt;
+    std::uniform_int_distribution<int> laneDist(0, laneCount - 1);
+
+    for (int attempt = 0; attempt < maxPlacementRetries; ++attempt) {
+        ObstacleSpec spec;
+        spec.lane = laneDist(rng);
+        spec.y = randomFloat(minY, maxY);
+        spec.width = randomFloat(layout.minWidth, layout.maxWidth);
+        spec.height = randomFloat(layout.minHeight, layout.maxHeight);
+        spec.x = randomXInLane(spec.lane, spec.width);
+
+        const float top = spec.y - spec.height / 2.0f;
+        const float bottom = spec.y + spec.height / 2.0f;
+        if (index.isClear(spec.lane, top, bottom, layout.minVerticalGapSameLane, layout.minVerticalGapAdjacentLane)) {
+            insert(spec);
+            return spec;
+        }
+    }
+    return std::nullopt;
+}
+
+size_t ObstacleGenerator::sampleCourse(int count, float minY, float maxY, const ObstacleLayout& layout,
+                                       std::vector<ObstacleSpec>& placed) {
+    const size_t firstIndex = placed.size();
+    if (count <= 0 || laneCount <= 0 || maxY <= minY) return 0;
+    placed.reserve(firstIndex + count);
+
+    // Each lane is a 1D hard-core process: consecutive obstacles are at least
+    // minVerticalGapSameLane apart plus a random extra sized to hit the target density.
+    const float perLaneCount = static_cast<float>(count) / static_cast<float>(laneCount);
+    const float slotLength = (maxY - minY) / perLaneCount;
+    const float meanHeight = (layout.minHeight + layout.maxHeight) / 2.0f;
+    const float extraGapMean = std::max(0.0f, slotLength - meanHeight - layout.minVerticalGapSameLane);
+
+    // Largest bottom edge allowed for the next obstacle of each lane (Y decreases ahead)
+    std::vector<float> cursors(laneCount, maxY);
+    std::vector<bool> laneOpen(laneCount, true);
+
+    while (static_cast<int>(placed.size() - firstIndex) < count) {
+        // Sweep all lanes together so adjacent-lane checks see their neighbours
+        int lane = -1;
+        for (int l = 0; l < laneCount; ++l) {
+            if (laneOpen[l] && (lane == -1 || cursors[l] > cursors[lane])) lane = l;
+        }
+        if (lane == -1) break;
+
+        const float height = randomFloat(layout.minHeight, layout.maxHeight);
+        const float width = randomFloat(layout.minWidth, layout.maxWidth);
+        float bottom = cursors[lane] - randomFloat(0.0f, 2.0f * extraGapMean);
+
+        bool fits = false;
+        while (true) {
+            const float top = bottom - height;
+            if (top < minY) break;
+            auto clearBottom = index.nextClearBottom(lane, top, bottom,
+                                                     layout.minVerticalGapSameLane, layout.minVerticalGapAdjacentLane);
+            if (!clearBottom) { fits = true; break; }
+            // Step past the conflicts (with a small margin against rounding), so this terminates
+            bottom = std::min(*clearBottom, bottom) - 0.01f;
+        }
+
+        if (!fits) {
+            laneOpen[lane] = false;
+            continue;
+        }
+
+        ObstacleSpec spec;
+        spec.lane = lane;
+        spec.width = width;
+        spec.height = height;
+        spec.y = bottom - height / 2.0f;
+        spec.x = randomXInLane(lane, width);
+        insert(spec);
+        placed.push_back(spec);
+
+        cursors[lane] = bottom - height - layout.minVerticalGapSameLane;
+    }
+    return placed.size() - firstIndex;
+}
+
+uint32_t ObstacleGenerator::chunkSeed(uint64_t courseSeed, long long chunkIndex) {
+    // splitmix64 finaliser over the (seed, index) pair
+    uint64_t z = courseSeed + 0x9E3779B97F4A7C15ULL * (static_cast<uint64_t>(chunkIndex) + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return static_cast<uint32_t>(z ^ (z >> 32));
+}
+
+size_t ObstacleGenerator::sampleChunk(uint64_t courseSeed, long long chunkIndex, const CourseLayout& course,
+                                      std::vector<ObstacleSpec>& placed) {
+    clear();
+    seed(chunkSeed(courseSeed, chunkIndex));
+    const float edgeMargin = course.obstacles.minVerticalGapSameLane / 2.0f;
+    return sampleCourse(course.obstaclesPerChunk,
+                        course.chunkFrontY(chunkIndex) + edgeMargin,
+                        course.chunkBackY(chunkIndex) - edgeMargin,
+                        course.obstacles, placed);
+}
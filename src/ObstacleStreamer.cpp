@@ -0,0 +1,119 @@
+#include "ObstacleStreamer.hpp"
+
+ObstacleStreamer::ObstacleStreamer(float roadLeft, float roadWidth, int laneCount, const CourseLayout& courseLayout)
+    : course(courseLayout), generator(roadLeft, roadWidth, laneCount)
+{
+    worker = std::thread(&ObstacleStreamer::workerLoop, this);
+}
+
+ObstacleStreamer::~ObstacleStreamer() {
+    running.store(false, std::memory_order_release);
+    wakeWorker();
+    {
+        std::lock_guard<std::mutex> lock(readyMutex);
+    }
+    readyCondition.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void ObstacleStreamer::wakeWorker() {
+    {
+        // The worker checks its state under this lock, so a change made before it cannot be missed
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wakeCondition.notify_one();
+}
+
+void ObstacleStreamer::restart(uint64_t seed, long long initialChunks, const Scenario* scenario) {
+    courseSeed.store(seed, std::memory_order_relaxed);
+    courseScenario.store(scenario, std::memory_order_relaxed);
+    requestedChunk.store(initialChunks - 1, std::memory_order_relaxed);
+    // Publishing the epoch last makes the seed and request visible together with it
+    currentEpoch.fetch_add(1, std::memory_order_release);
+    wakeWorker();
+}
+
+void ObstacleStreamer::requestUpTo(long long chunkIndex) {
+    long long previous = requestedChunk.load(std::memory_order_relaxed);
+    if (chunkIndex <= previous) return;
+    requestedChunk.store(chunkIndex, std::memory_order_release);
+    wakeWorker();
+}
+
+bool ObstacleStreamer::poll(ObstacleChunk& chunk) {
+    const uint64_t epoch = currentEpoch.load(std::memory_order_relaxed);
+    bool found = false;
+    while (!found && readyChunks.pop(chunk)) {
+        if (chunk.epoch == epoch) {
+            found = true;
+        } else {
+            recycle(std::move(chunk)); // Left over from a previous course
+        }
+    }
+    if (found) wakeWorker(); // The worker may have been waiting for a free slot
+    return found;
+}
+
+bool ObstacleStreamer::waitForChunk(ObstacleChunk& chunk) {
+    if (poll(chunk)) return true; // Usually the worker is ahead
+    bool found = false;
+    std::unique_lock<std::mutex> lock(readyMutex);
+    readyCondition.wait(lock, [&] {
+        found = poll(chunk);
+        return found || !running.load(std::memory_order_acquire);
+    });
+    return found;
+}
+
+void ObstacleStreamer::recycle(ObstacleChunk&& chunk) {
+    chunk.specs.clear();
+    recycledChunks.push(std::move(chunk)); // If the pool is full the chunk is simply freed
+}
+
+void ObstacleStreamer::workerLoop() {
+    uint64_t activeEpoch = 0;
+    long long nextChunk = 0;
+    ObstacleChunk chunk;
+
+    while (true) {
+        uint64_t epoch = 0;
+        {
+            // Sleep until the simulation asks for more, starts another course or frees a slot
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCondition.wait(lock, [&] {
+                epoch = currentEpoch.load(std::memory_order_acquire);
+                if (epoch != activeEpoch) {
+                    activeEpoch = epoch;
+                    nextChunk = 0;
+                }
+                return !running.load(std::memory_order_acquire) ||
+                       (epoch != 0 && nextChunk <= requestedChunk.load(std::memory_order_acquire) && !readyChunks.full());
+            });
+        }
+        if (!running.load(std::memory_order_acquire)) return;
+
+        ObstacleChunk recycled;
+        if (recycledChunks.pop(recycled)) {
+            chunk = std::move(recycled);
+        }
+        chunk.index = nextChunk;
+        chunk.epoch = epoch;
+        chunk.specs.clear();
+        const Scenario* scenario = courseScenario.load(std::memory_order_relaxed);
+        if (const std::vector<ObstacleSpec>* stored = scenario ? scenario->findChunk(nextChunk) : nullptr) {
+            chunk.specs.assign(stored->begin(), stored->end());
+        } else {
+            generator.sampleChunk(courseSeed.load(std::memory_order_relaxed), nextChunk, course, chunk.specs);
+        }
+
+        if (readyChunks.push(std::move(chunk))) {
+            ++nextChunk;
+            {
+                std::lock_guard<std::mutex> lock(readyMutex);
+            }
+            readyCondition.notify_one();
+        }
+    }
+}
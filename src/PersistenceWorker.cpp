@@ -0,0 +1,75 @@
+#include "PersistenceWorker.hpp"
+#include "FileUtils.hpp"
+#include <chrono>
+#include <iostream>
+
+PersistenceWorker::PersistenceWorker()
+    : worker(&PersistenceWorker::workerLoop, this)
+{
+}
+
+PersistenceWorker::~PersistenceWorker() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    workAvailable.notify_one();
+    if (worker.joinable()) worker.join();
+}
+
+void PersistenceWorker::save(const std::string& filename, Serializer serializer) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        auto it = pending.find(filename);
+        if (it != pending.end()) {
+            it->second = std::move(serializer);
+            savesCoalesced.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            pending.emplace(filename, std::move(serializer));
+        }
+    }
+    workAvailable.notify_one();
+}
+
+void PersistenceWorker::flush() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueDrained.wait(lock, [this] { return pending.empty() && !writing; });
+}
+
+void PersistenceWorker::workerLoop() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true) {
+        workAvailable.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (pending.empty()) return; // Stopping with nothing left to write
+
+        std::string filename = pending.begin()->first;
+        Serializer serializer = std::move(pending.begin()->second);
+        pending.erase(pending.begin());
+        writing = true;
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        bool ok = false;
+        try {
+            ok = writeFileAtomic(filename, serializer());
+        } catch (const std::exception& e) {
+            std::cerr << "Error serializing " << filename << ": " << e.what() << std::endl;
+        }
+        const float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        lastWriteMs.store(elapsedMs, std::memory_order_relaxed);
+        if (elapsedMs > maxWriteMs.load(std::memory_order_relaxed)) {
+            maxWriteMs.store(elapsedMs, std::memory_order_relaxed);
+        }
+        if (ok) {
+            writesCompleted.fetch_add(1, std::memory_order_relaxed);
+            std::cout << "Saved " << filename << " in " << elapsedMs << " ms (background)." << std::endl;
+        } else {
+            std::cerr << "Error saving " << filename << " in the background." << std::endl;
+        }
+
+        lock.lock();
+        writing = false;
+        if (pending.empty()) queueDrained.notify_all();
+    }
+}
@@ -0,0 +1,103 @@
+#include "PopulationRenderer.hpp"
+#include "Car.hpp"
+#include <algorithm>
+#include <cmath>
+
+void PopulationRenderer::draw(sf::RenderTarget& target, const std::vector<CarPose>& cars, int excluded,
+                              const sf::FloatRect& visibleArea) {
+    const sf::Texture* texture = Car::getSharedTexture();
+    const sf::Vector2f textureSize = texture ? sf::Vector2f(texture->getSize()) : sf::Vector2f(0.f, 0.f);
+
+    sortByY(cars);
+    vertices.clear();
+    carsDrawn = 0;
+    carsCulled = 0;
+
+    // A rotated car reaches at most half its diagonal from its centre
+    float margin = 0.0f;
+    for (const CarPose& car : cars) margin = std::max(margin, std::hypot(car.width, car.height) / 2.0f);
+    const float top = visibleArea.position.y - margin;
+    const float bottom = visibleArea.position.y + visibleArea.size.y + margin;
+    const float left = visibleArea.position.x - margin;
+    const float right = visibleArea.position.x + visibleArea.size.x + margin;
+
+    auto first = std::lower_bound(carsByY.begin(), carsByY.end(), top,
+                                  [&cars](size_t index, float y) { return cars[index].position.y < y; });
+    auto last = first;
+    for (; last != carsByY.end() && cars[*last].position.y <= bottom; ++last) {
+        const CarPose& car = cars[*last];
+        if (static_cast<int>(*last) == excluded) continue;
+        if (car.position.x < left || car.position.x > right) {
+            carsCulled++;
+            continue;
+        }
+        appendCar(vertices, car, textureSize);
+        carsDrawn++;
+    }
+    carsCulled += static_cast<size_t>(first - carsByY.begin()) + static_cast<size_t>(carsByY.end() - last);
+    if (vertices.getVertexCount() == 0) return;
+
+    sf::RenderStates states;
+    states.texture = texture; // Untextured quads in the car colour if the texture is missing
+    target.draw(vertices, states);
+}
+
+void PopulationRenderer::drawSingle(sf::RenderTarget& target, const CarPose& car) {
+    const sf::Texture* texture = Car::getSharedTexture();
+    const sf::Vector2f textureSize = texture ? sf::Vector2f(texture->getSize()) : sf::Vector2f(0.f, 0.f);
+    singleCar.clear();
+    appendCar(singleCar, car, textureSize);
+
+    sf::RenderStates states;
+    states.texture = texture;
+    target.draw(singleCar, states);
+}
+
+void PopulationRenderer::sortByY(const std::vector<CarPose>& cars) {
+    auto byY = [&cars](size_t a, size_t b) { return cars[a].position.y < cars[b].position.y; };
+    // A new car count means the indices now name other cars: sort afresh
+    if (carsByY.size() != cars.size()) {
+        carsByY.resize(cars.size());
+        for (size_t i = 0; i < cars.size(); ++i) carsByY[i] = i;
+        std::sort(carsByY.begin(), carsByY.end(), byY);
+        return;
+    }
+    // Insertion sort: cars move little between frames, so this is close to one linear pass
+    for (size_t i = 1; i < carsByY.size(); ++i) {
+        const size_t index = carsByY[i];
+        size_t j = i;
+        while (j > 0 && byY(index, carsByY[j - 1])) {
+            carsByY[j] = carsByY[j - 1];
+            --j;
+        }
+        carsByY[j] = index;
+    }
+}
+
+void PopulationRenderer::appendCar(sf::VertexArray& into, const CarPose& car, sf::Vector2f textureSize) {
+    // Corners of the car rectangle rotated by its heading (radians, as in Car::getPolygon)
+    const float sine = std::sin(car.angle);
+    const float cosine = std::cos(car.angle);
+    const float halfWidth = car.width / 2.0f;
+    const float halfHeight = car.height / 2.0f;
+    auto corner = [&](float x, float y) {
+        return sf::Vector2f(car.position.x + x * cosine - y * sine, car.position.y + x * sine + y * cosine);
+    };
+    const sf::Vector2f topLeft = corner(-halfWidth, -halfHeight);
+    const sf::Vector2f topRight = corner(halfWidth, -halfHeight);
+    const sf::Vector2f bottomRight = corner(halfWidth, halfHeight);
+    const sf::Vector2f bottomLeft = corner(-halfWidth, halfHeight);
+
+    const sf::Color color = car.color;
+    const sf::Vector2f texTopLeft(0.f, 0.f);
+    const sf::Vector2f texTopRight(textureSize.x, 0.f);
+    const sf::Vector2f texBottomRight(textureSize.x, textureSize.y);
+    const sf::Vector2f texBottomLeft(0.f, textureSize.y);
+
+    into.append(sf::Vertex{topLeft, color, texTopLeft});
+    into.append(sf::Vertex{topRight, color, texTopRight});
+    into.append(sf::Vertex{bottomRight, color, texBottomRight});
+    into.append(sf::Vertex{topLeft, color, texTopLeft});
+    into.append(sf::Vertex{bottomRight, color, texBottomRight});
+    into.append(sf::Vertex{bottomLeft, color, texBottomLeft});
+}
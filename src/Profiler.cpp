@@ -0,0 +1,186 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+
+thread_local Profiler::Track* Profiler::threadTrack = nullptr;
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+const char* Profiler::phaseName(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::SENSORS: return "Sensors";
+        case ProfilePhase::CONTROLS: return "Controls/inference";
+        case ProfilePhase::MOVE: return "Move";
+        case ProfilePhase::COLLISION: return "Collision";
+        case ProfilePhase::OBSTACLES: return "Obstacles";
+        case ProfilePhase::GENETIC_ALGORITHM: return "GA bookkeeping";
+        case ProfilePhase::SNAPSHOT: return "Snapshot";
+        case ProfilePhase::RENDER_PANELS: return "Panels";
+        case ProfilePhase::RENDER_WORLD: return "World";
+        case ProfilePhase::RENDER_NETWORK: return "Network";
+        case ProfilePhase::PRESENT: return "Present";
+        case ProfilePhase::COUNT: break;
+    }
+    return "?";
+}
+
+const char* Profiler::phaseKey(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::SENSORS: return "sensors";
+        case ProfilePhase::CONTROLS: return "controls";
+        case ProfilePhase::MOVE: return "move";
+        case ProfilePhase::COLLISION: return "collision";
+        case ProfilePhase::OBSTACLES: return "obstacles";
+        case ProfilePhase::GENETIC_ALGORITHM: return "genetic_algorithm";
+        case ProfilePhase::SNAPSHOT: return "snapshot";
+        case ProfilePhase::RENDER_PANELS: return "render_panels";
+        case ProfilePhase::RENDER_WORLD: return "render_world";
+        case ProfilePhase::RENDER_NETWORK: return "render_network";
+        case ProfilePhase::PRESENT: return "present";
+        case ProfilePhase::COUNT: break;
+    }
+    return "unknown";
+}
+
+const char* Profiler::trackKey(ProfileTrack track) {
+    return track == ProfileTrack::SIMULATION ? "simulation" : "render";
+}
+
+ProfileTrack Profiler::trackOf(ProfilePhase phase) {
+    return static_cast<size_t>(phase) < static_cast<size_t>(ProfilePhase::RENDER_PANELS) ? ProfileTrack::SIMULATION
+                                                                                       : ProfileTrack::RENDER;
+}
+
+void Profiler::attachThread(ProfileTrack track) {
+    threadTrack = &tracks[static_cast<size_t>(track)];
+    threadTrack->inFrame = false;
+}
+
+void Profiler::detachThread() {
+    threadTrack = nullptr;
+}
+
+void Profiler::beginFrame() {
+    if (!threadTrack) return;
+    threadTrack->current = Frame();
+    threadTrack->frameStart = std::chrono::steady_clock::now();
+    threadTrack->inFrame = true;
+}
+
+void Profiler::endFrame() {
+    Track* track = threadTrack;
+    if (!track || !track->inFrame) return;
+    track->inFrame = false;
+    track->current.totalMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - track->frameStart).count();
+
+    std::lock_guard<std::mutex> lock(track->mutex);
+    track->current.number = track->frameCount++;
+    if (track->ring.size() < FRAME_CAPACITY) {
+        track->ring.push_back(track->current);
+    } else {
+        track->ring[track->next] = track->current;
+    }
+    track->next = (track->next + 1) % FRAME_CAPACITY;
+}
+
+void Profiler::add(ProfilePhase phase, float milliseconds) {
+    if (threadTrack) threadTrack->current.phaseMs[static_cast<size_t>(phase)] += milliseconds;
+}
+
+Profiler::Recording Profiler::getRecording() const {
+    Recording recording;
+    for (size_t t = 0; t < TRACK_COUNT; ++t) {
+        const Track& track = tracks[t];
+        std::lock_guard<std::mutex> lock(track.mutex);
+        std::vector<Frame>& frames = recording[t];
+        frames.reserve(track.ring.size());
+        // Once the ring is full, 'next' is the oldest frame
+        const size_t oldest = track.ring.size() < FRAME_CAPACITY ? 0 : track.next;
+        for (size_t i = 0; i < track.ring.size(); ++i) {
+            frames.push_back(track.ring[(oldest + i) % track.ring.size()]);
+        }
+    }
+    return recording;
+}
+
+Profiler::Stats Profiler::statsOf(const std::vector<Frame>& frames, size_t phase) {
+    Stats stats;
+    if (frames.empty()) return stats;
+    std::vector<float> values;
+    values.reserve(frames.size());
+    double sum = 0.0;
+    for (const Frame& frame : frames) {
+        const float value = phase == TOTAL ? frame.totalMs : frame.phaseMs[phase];
+        values.push_back(value);
+        sum += value;
+    }
+    // Nearest-rank percentiles
+    auto percentile = [&values](float fraction) {
+        const size_t rank = static_cast<size_t>(fraction * static_cast<float>(values.size() - 1) + 0.5f);
+        std::nth_element(values.begin(), values.begin() + rank, values.end());
+        return values[rank];
+    };
+    stats.p50 = percentile(0.50f);
+    stats.p99 = percentile(0.99f);
+    stats.mean = static_cast<float>(sum / static_cast<double>(values.size()));
+    return stats;
+}
+
+std::string Profiler::toCsv(const Recording& recording) {
+    std::string csv = "track,frame,total_ms";
+    for (size_t p = 0; p < PHASE_COUNT; ++p) {
+        csv += ",";
+        csv += phaseKey(static_cast<ProfilePhase>(p));
+        csv += "_ms";
+    }
+    csv += "\n";
+
+    char value[32];
+    for (size_t t = 0; t < TRACK_COUNT; ++t) {
+        for (const Frame& frame : recording[t]) {
+            csv += trackKey(static_cast<ProfileTrack>(t));
+            csv += "," + std::to_string(frame.number);
+            std::snprintf(value, sizeof(value), ",%.4f", frame.totalMs);
+            csv += value;
+            for (size_t p = 0; p < PHASE_COUNT; ++p) {
+                std::snprintf(value, sizeof(value), ",%.4f", frame.phaseMs[p]);
+                csv += value;
+            }
+            csv += "\n";
+        }
+    }
+    return csv;
+}
+
+std::string Profiler::toJson(const Recording& recording) {
+    char buffer[96];
+    auto statsJson = [&buffer](const Stats& stats) {
+        std::snprintf(buffer, sizeof(buffer), "{\"p50_ms\": %.4f, \"p99_ms\": %.4f, \"mean_ms\": %.4f}",
+                      stats.p50, stats.p99, stats.mean);
+        return std::string(buffer);
+    };
+
+    std::string json = "{\n  \"tracks\": {\n";
+    for (size_t t = 0; t < TRACK_COUNT; ++t) {
+        const ProfileTrack track = static_cast<ProfileTrack>(t);
+        const std::vector<Frame>& frames = recording[t];
+        json += std::string("    \"") + trackKey(track) + "\": {\n";
+        json += "      \"frames\": " + std::to_string(frames.size()) + ",\n";
+        json += "      \"total\": " + statsJson(statsOf(frames, TOTAL)) + ",\n";
+        json += "      \"phases\": {";
+        bool first = true;
+        for (size_t p = 0; p < PHASE_COUNT; ++p) {
+            if (trackOf(static_cast<ProfilePhase>(p)) != track) continue;
+            json += first ? "\n" : ",\n";
+            json += std::string("        \"") + phaseKey(static_cast<ProfilePhase>(p)) + "\": " + statsJson(statsOf(frames, p));
+            first = false;
+        }
+        json += "\n      }\n    }";
+        json += t + 1 < TRACK_COUNT ? ",\n" : "\n";
+    }
+    json += "  }\n}\n";
+    return json;
+}
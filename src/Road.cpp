@@ -42,32 +42,48 @@ int Road::getLaneIndex(float xPos){
     }
     return -1; // Return -1 if position is outside the road
 }
-void Road::draw(sf::RenderTarget& target) {
-    if (laneCount > 1) {
-        sf::VertexArray laneLines(sf::PrimitiveType::Lines);
-        const float dashLength = 20.0f;
-        const float gapLength = 15.0f;
-        for (int i = 1; i < laneCount; ++i) {
-            float laneX = lerp(left, right, static_cast<float>(i) / static_cast<float>(laneCount));
-            float currentY = top;
-            while (currentY < bottom) {
-                float endOfDashY = std::min(currentY + dashLength, bottom);
-                laneLines.append(sf::Vertex{{laneX, currentY}, sf::Color::Yellow});
-                laneLines.append(sf::Vertex{{laneX, endOfDashY}, sf::Color::Yellow});
-                currentY += dashLength + gapLength;
-            }
+void Road::buildLaneDashTile(float minLength) {
+    const float period = DASH_LENGTH + GAP_LENGTH;
+    const int dashCount = static_cast<int>(std::ceil(minLength / period));
+    laneDashTileLength = dashCount * period;
+    laneDashTile.clear();
+    for (int i = 1; i < laneCount; ++i) {
+        float laneX = lerp(left, right, static_cast<float>(i) / static_cast<float>(laneCount));
+        for (int dash = 0; dash < dashCount; ++dash) {
+            const float dashY = dash * period;
+            laneDashTile.append(sf::Vertex{{laneX, dashY}, sf::Color::Yellow});
+            laneDashTile.append(sf::Vertex{{laneX, dashY + DASH_LENGTH}, sf::Color::Yellow});
         }
-        if (laneLines.getVertexCount() > 0) {
-            target.draw(laneLines);
+    }
+}
+
+void Road::draw(sf::RenderTarget& target, const sf::FloatRect& visibleArea) {
+    const float viewTop = std::max(top, visibleArea.position.y);
+    const float viewBottom = std::min(bottom, visibleArea.position.y + visibleArea.size.y);
+    if (viewTop >= viewBottom) return;
+
+    if (laneCount > 1) {
+        const float period = DASH_LENGTH + GAP_LENGTH;
+        // One extra period so the tile still covers the view after snapping its start down
+        if (laneDashTileLength < viewBottom - viewTop + period) {
+            buildLaneDashTile(viewBottom - viewTop + period);
         }
+        // Dashes start at 'top' and repeat every period; snap the tile to that phase
+        // (in double, as 'top' is a million units away from where the cars are)
+        const double periodsFromTop = std::floor((static_cast<double>(viewTop) - top) / period);
+        const float tileY = static_cast<float>(top + periodsFromTop * period);
+        sf::RenderStates states;
+        states.transform.translate({0.f, tileY});
+        target.draw(laneDashTile, states);
     }
 
+    // The borders span the whole road for collisions, but only their visible part is drawn
     sf::VertexArray borderLines(sf::PrimitiveType::Lines);
     for (const auto& border : borders) {
-        borderLines.append(sf::Vertex{border.first, sf::Color::White});
-        borderLines.append(sf::Vertex{border.second, sf::Color::White});
+        borderLines.append(sf::Vertex{{border.first.x, viewTop}, sf::Color::White});
+        borderLines.append(sf::Vertex{{border.second.x, viewBottom}, sf::Color::White});
     }
     if (borderLines.getVertexCount() > 0) {
         target.draw(borderLines);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,165 @@
+#include "ScenarioBank.hpp"
+#include "FileUtils.hpp"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+
+namespace {
+template <typename T>
+void writeValue(std::ostream& stream, const T& value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream& stream, T& value) {
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(stream);
+}
+
+// Guards against allocating from a corrupt count: each element needs at least 'minBytes' of the file
+bool countFits(std::istream& stream, size_t fileSize, uint64_t count, uint64_t maxCount, uint64_t minBytes) {
+    const std::streamoff position = stream.tellg();
+    if (position < 0 || count > maxCount) return false;
+    return count * minBytes <= fileSize - static_cast<size_t>(position);
+}
+
+constexpr uint64_t SPEC_BYTES = 4 * sizeof(float) + sizeof(int8_t);
+constexpr uint64_t CHUNK_MIN_BYTES = sizeof(uint32_t);
+constexpr uint64_t SCENARIO_MIN_BYTES = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t);
+}
+
+ScenarioBank::ScenarioBank(float left, float width, int lanes, const CourseLayout& courseLayout)
+    : roadLeft(left), roadWidth(width), laneCount(lanes), course(courseLayout)
+{
+}
+
+void ScenarioBank::generate(int scenarioCount, int chunksPerScenario, uint64_t baseSeed) {
+    scenarios.clear();
+    scenarios.reserve(std::max(0, scenarioCount));
+    ObstacleGenerator generator(roadLeft, roadWidth, laneCount);
+
+    for (int i = 0; i < scenarioCount; ++i) {
+        Scenario scenario;
+        scenario.id = static_cast<uint32_t>(i);
+        scenario.seed = ObstacleGenerator::chunkSeed(baseSeed, -1 - i); // Decorrelated from chunk seeds
+        scenario.chunks.resize(std::max(0, chunksPerScenario));
+        for (int c = 0; c < chunksPerScenario; ++c) {
+            generator.sampleChunk(scenario.seed, c, course, scenario.chunks[c]);
+        }
+        scenarios.push_back(std::move(scenario));
+    }
+}
+
+uint32_t ScenarioBank::scenarioForGeneration(int generation, int subsetSize) const {
+    if (scenarios.empty()) return 0;
+    const int subset = std::max(1, std::min(subsetSize, static_cast<int>(scenarios.size())));
+    return static_cast<uint32_t>(std::max(0, generation - 1) % subset);
+}
+
+std::string ScenarioBank::serialize() const {
+    std::ostringstream stream(std::ios::binary);
+    writeValue(stream, FILE_MAGIC);
+    writeValue(stream, FILE_VERSION);
+    writeValue(stream, static_cast<int32_t>(laneCount));
+    writeValue(stream, roadLeft);
+    writeValue(stream, roadWidth);
+    writeValue(stream, course.chunkLength);
+    writeValue(stream, course.startY);
+    writeValue(stream, static_cast<int32_t>(course.obstaclesPerChunk));
+    writeValue(stream, course.obstacles);
+    writeValue(stream, static_cast<uint32_t>(scenarios.size()));
+    for (const Scenario& scenario : scenarios) {
+        writeValue(stream, scenario.id);
+        writeValue(stream, scenario.seed);
+        writeValue(stream, static_cast<uint32_t>(scenario.chunks.size()));
+        for (const auto& chunk : scenario.chunks) {
+            writeValue(stream, static_cast<uint32_t>(chunk.size()));
+            for (const ObstacleSpec& spec : chunk) {
+                writeValue(stream, spec.x);
+                writeValue(stream, spec.y);
+                writeValue(stream, spec.width);
+                writeValue(stream, spec.height);
+                writeValue(stream, static_cast<int8_t>(spec.lane));
+            }
+        }
+    }
+    return stream.str();
+}
+
+bool ScenarioBank::saveToFile(const std::string& filename) const {
+    return writeFileAtomic(filename, serialize());
+}
+
+bool ScenarioBank::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    const std::string contents{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    std::istringstream stream(contents, std::ios::binary);
+
+    uint32_t magic = 0, version = 0, scenarioCount = 0;
+    int32_t fileLaneCount = 0, obstaclesPerChunk = 0;
+    float fileRoadLeft = 0.0f, fileRoadWidth = 0.0f, chunkLength = 0.0f, startY = 0.0f;
+    ObstacleLayout obstacles{};
+    auto corrupt = [&filename]() {
+        std::cerr << "Warning: Scenario bank " << filename << " is truncated or corrupt." << std::endl;
+        return false;
+    };
+    if (!readValue(stream, magic) || magic != FILE_MAGIC || !readValue(stream, version) || version != FILE_VERSION) {
+        std::cerr << "Warning: " << filename << " is not a compatible scenario bank." << std::endl;
+        return false;
+    }
+    if (!readValue(stream, fileLaneCount) || !readValue(stream, fileRoadLeft) || !readValue(stream, fileRoadWidth) ||
+        !readValue(stream, chunkLength) || !readValue(stream, startY) || !readValue(stream, obstaclesPerChunk) ||
+        !readValue(stream, obstacles)) {
+        return corrupt();
+    }
+    if (fileLaneCount != laneCount || fileRoadLeft != roadLeft || fileRoadWidth != roadWidth ||
+        chunkLength != course.chunkLength || startY != course.startY || obstaclesPerChunk != course.obstaclesPerChunk ||
+        obstacles.minWidth != course.obstacles.minWidth || obstacles.maxWidth != course.obstacles.maxWidth ||
+        obstacles.minHeight != course.obstacles.minHeight || obstacles.maxHeight != course.obstacles.maxHeight ||
+        obstacles.minVerticalGapAdjacentLane != course.obstacles.minVerticalGapAdjacentLane ||
+        obstacles.minVerticalGapSameLane != course.obstacles.minVerticalGapSameLane) {
+        std::cerr << "Warning: Scenario bank '" << filename << "' was made for a different road/course layout." << std::endl;
+        return false;
+    }
+
+    if (!readValue(stream, scenarioCount) ||
+        !countFits(stream, contents.size(), scenarioCount, MAX_SCENARIOS, SCENARIO_MIN_BYTES)) {
+        return corrupt();
+    }
+
+    std::vector<Scenario> loaded(scenarioCount);
+    for (uint32_t i = 0; i < scenarioCount; ++i) {
+        Scenario& scenario = loaded[i];
+        uint32_t chunkCount = 0;
+        if (!readValue(stream, scenario.id) || !readValue(stream, scenario.seed) || !readValue(stream, chunkCount) ||
+            scenario.id != i ||
+            !countFits(stream, contents.size(), chunkCount, MAX_CHUNKS_PER_SCENARIO, CHUNK_MIN_BYTES)) {
+            return corrupt();
+        }
+        scenario.chunks.resize(chunkCount);
+        for (auto& chunk : scenario.chunks) {
+            uint32_t specCount = 0;
+            if (!readValue(stream, specCount) ||
+                !countFits(stream, contents.size(), specCount, static_cast<uint64_t>(course.obstaclesPerChunk), SPEC_BYTES)) {
+                return corrupt();
+            }
+            chunk.resize(specCount);
+            for (ObstacleSpec& spec : chunk) {
+                int8_t lane = -1;
+                if (!readValue(stream, spec.x) || !readValue(stream, spec.y) || !readValue(stream, spec.width) ||
+                    !readValue(stream, spec.height) || !readValue(stream, lane) || lane < 0 || lane >= laneCount) {
+                    return corrupt();
+                }
+                spec.lane = lane;
+            }
+        }
+    }
+
+    scenarios = std::move(loaded);
+    return true;
+}
@@ -0,0 +1,62 @@
+#include "ScenarioEvaluator.hpp"
+#include "Network.hpp"
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+#include <iostream>
+
+ScenarioEvaluator::ScenarioEvaluator(const Road& road, const CourseLayout& course, size_t workerCount)
+    : pool(workerCount)
+{
+    worlds.reserve(pool.getWorkerCount());
+    for (size_t i = 0; i < pool.getWorkerCount(); ++i) {
+        worlds.push_back(std::make_unique<HeadlessWorld>(road, course));
+    }
+}
+
+std::vector<float> ScenarioEvaluator::evaluate(const std::vector<const NeuralNetwork*>& genomes,
+                                               const std::vector<const Scenario*>& scenarios,
+                                               float maxSeconds,
+                                               FitnessAggregation aggregation,
+                                               float quantile,
+                                               const std::atomic<bool>* cancelled) {
+    const size_t scenarioCount = scenarios.size();
+    std::vector<float> fitness(genomes.size() * scenarioCount, -std::numeric_limits<float>::infinity());
+
+    pool.run(fitness.size(), [&](size_t taskIndex, size_t workerIndex) {
+        const NeuralNetwork* genome = genomes[taskIndex / scenarioCount];
+        const Scenario* scenario = scenarios[taskIndex % scenarioCount];
+        if (!genome || !scenario || (cancelled && cancelled->load(std::memory_order_relaxed))) return;
+        try {
+            fitness[taskIndex] = worlds[workerIndex]->evaluate(*genome, *scenario, maxSeconds);
+        } catch (const std::exception& e) {
+            std::cerr << "Error evaluating genome " << taskIndex / scenarioCount << ": " << e.what() << std::endl;
+        }
+    });
+
+    std::vector<float> aggregated(genomes.size(), -std::numeric_limits<float>::infinity());
+    for (size_t g = 0; g < genomes.size() && scenarioCount > 0; ++g) {
+        aggregated[g] = aggregate(std::vector<float>(fitness.begin() + g * scenarioCount,
+                                                     fitness.begin() + (g + 1) * scenarioCount),
+                                  aggregation, quantile);
+    }
+    return aggregated;
+}
+
+float ScenarioEvaluator::aggregate(std::vector<float> values, FitnessAggregation aggregation, float quantile) {
+    if (values.empty()) return -std::numeric_limits<float>::infinity();
+    if (aggregation == FitnessAggregation::MEAN) {
+        return std::accumulate(values.begin(), values.end(), 0.0f) / static_cast<float>(values.size());
+    }
+    const float clamped = std::max(0.0f, std::min(1.0f, quantile));
+    const size_t rank = static_cast<size_t>(std::round(clamped * (values.size() - 1)));
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+long long ScenarioEvaluator::getTicksSimulated() const {
+    long long total = 0;
+    for (const auto& world : worlds) total += world->getTicksSimulated();
+    return total;
+}
@@ -0,0 +1,96 @@
+#include "Selection.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+SelectionSettings multiParentSelection(CrossoverMode crossover) {
+    SelectionSettings settings;
+    settings.eliteCount = 2;
+    settings.matingPoolSize = 16;
+    settings.tournamentSize = 3;
+    settings.crossover = crossover;
+    return settings;
+}
+
+float scheduledMutationRate(float initialRate, float minRate, float decayFactor, int generation) {
+    const float rate = minRate + (initialRate - minRate) * std::exp(-decayFactor * static_cast<float>(generation));
+    return std::max(minRate, rate);
+}
+
+std::vector<size_t> selectTopIndices(const std::vector<float>& fitness, size_t count) {
+    std::vector<size_t> indices(fitness.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    count = std::min(count, indices.size());
+    std::partial_sort(indices.begin(), indices.begin() + count, indices.end(),
+                      [&](size_t a, size_t b) { return fitness[a] > fitness[b]; });
+    indices.resize(count);
+    return indices;
+}
+
+size_t tournamentSelect(const std::vector<size_t>& candidates, const std::vector<float>& fitness, int tournamentSize) {
+    const int lastCandidate = static_cast<int>(candidates.size()) - 1;
+    size_t winner = candidates[getRandomInt(0, lastCandidate)];
+    for (int round = 1; round < tournamentSize; ++round) {
+        const size_t challenger = candidates[getRandomInt(0, lastCandidate)];
+        if (fitness[challenger] > fitness[winner]) winner = challenger;
+    }
+    return winner;
+}
+
+void crossoverUniform(const NeuralNetwork& a, const NeuralNetwork& b, NeuralNetwork& child) {
+    child = a;
+    for (size_t l = 0; l < child.levels.size() && l < b.levels.size(); ++l) {
+        Level& level = child.levels[l];
+        const Level& other = b.levels[l];
+        for (size_t i = 0; i < level.biases.size() && i < other.biases.size(); ++i) {
+            if (getRandom() < 0.5f) level.biases[i] = other.biases[i];
+        }
+        for (size_t i = 0; i < level.weights.size() && i < other.weights.size(); ++i) {
+            for (size_t j = 0; j < level.weights[i].size() && j < other.weights[i].size(); ++j) {
+                if (getRandom() < 0.5f) level.weights[i][j] = other.weights[i][j];
+            }
+        }
+    }
+}
+
+void crossoverLayerWise(const NeuralNetwork& a, const NeuralNetwork& b, NeuralNetwork& child) {
+    child = a;
+    for (size_t l = 0; l < child.levels.size() && l < b.levels.size(); ++l) {
+        if (getRandom() < 0.5f) {
+            child.levels[l].biases = b.levels[l].biases;
+            child.levels[l].weights = b.levels[l].weights;
+        }
+    }
+}
+
+void breedGeneration(const std::vector<NeuralNetwork>& parents, const std::vector<float>& fitness,
+                     float mutationRate, const SelectionSettings& settings, std::vector<NeuralNetwork>& offspring) {
+    if (parents.empty() || offspring.empty()) return;
+    const size_t poolSize = static_cast<size_t>(std::max(1, settings.matingPoolSize));
+    const size_t eliteCount = static_cast<size_t>(std::max(1, settings.eliteCount));
+    const std::vector<size_t> ranking = selectTopIndices(fitness, std::max(poolSize, eliteCount));
+    const std::vector<size_t> matingPool(ranking.begin(), ranking.begin() + std::min(poolSize, ranking.size()));
+
+    for (size_t i = 0; i < offspring.size(); ++i) {
+        if (i < eliteCount && i < ranking.size()) {
+            offspring[i] = parents[ranking[i]];
+            continue;
+        }
+        const size_t first = tournamentSelect(matingPool, fitness, settings.tournamentSize);
+        const bool crossover = settings.crossover != CrossoverMode::NONE && matingPool.size() > 1 &&
+                               getRandom() < settings.crossoverFraction;
+        if (crossover) {
+            const size_t second = tournamentSelect(matingPool, fitness, settings.tournamentSize);
+            if (settings.crossover == CrossoverMode::UNIFORM) {
+                crossoverUniform(parents[first], parents[second], offspring[i]);
+            } else {
+                crossoverLayerWise(parents[first], parents[second], offspring[i]);
+            }
+            NeuralNetwork::mutate(offspring[i], mutationRate * settings.crossoverMutationScale);
+        } else {
+            offspring[i] = parents[first];
+            NeuralNetwork::mutate(offspring[i], mutationRate * settings.cloneMutationScale);
+        }
+    }
+}
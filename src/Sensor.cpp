@@ -77,19 +77,15 @@ std::optional<IntersectionData> Sensor::getReading(
     }
 }
 
-void Sensor::draw(sf::RenderTarget& target) {
-    sf::VertexArray lines(sf::PrimitiveType::Lines);
-    for (int i = 0; i < rayCount; ++i) {
+void Sensor::appendRayVertices(std::vector<sf::Vertex>& lines) const {
+    for (int i = 0; i < rayCount && i < static_cast<int>(rays.size()); ++i) {
         sf::Vector2f rayEnd = rays[i].second;
-        if (readings[i]) {
+        if (i < static_cast<int>(readings.size()) && readings[i]) {
             rayEnd = readings[i]->point;
-            lines.append(sf::Vertex{rays[i].second, sf::Color::Black});
-            lines.append(sf::Vertex{rayEnd, sf::Color::Black});
+            lines.push_back(sf::Vertex{rays[i].second, sf::Color::Black});
+            lines.push_back(sf::Vertex{rayEnd, sf::Color::Black});
         }
-        lines.append(sf::Vertex{rays[i].first, sf::Color::Yellow});
-        lines.append(sf::Vertex{rayEnd, sf::Color::Yellow});
-    }
-    if (lines.getVertexCount() > 0) {
-        target.draw(lines);
+        lines.push_back(sf::Vertex{rays[i].first, sf::Color::Yellow});
+        lines.push_back(sf::Vertex{rayEnd, sf::Color::Yellow});
     }
 }
\ No newline at end of file
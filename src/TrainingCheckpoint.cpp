@@ -0,0 +1,132 @@
+#include "TrainingCheckpoint.hpp"
+#include "FileUtils.hpp"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+template <typename T>
+void writeValue(std::ostream& stream, const T& value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream& stream, T& value) {
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(stream);
+}
+
+template <typename T>
+void writeVector(std::ostream& stream, const std::vector<T>& values) {
+    writeValue(stream, static_cast<uint64_t>(values.size()));
+    stream.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T>
+bool readVector(std::istream& stream, std::vector<T>& values, uint64_t maxCount) {
+    uint64_t count = 0;
+    if (!readValue(stream, count) || count > maxCount) return false;
+    values.resize(static_cast<size_t>(count));
+    stream.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(T));
+    return static_cast<bool>(stream);
+}
+
+constexpr uint64_t MAX_VECTOR_ELEMENTS = 1ull << 26; // Guards against allocating from a corrupt size
+
+void writeHistory(std::ostream& stream, const HistoryStore& history) {
+    writeValue(stream, history.getBucketWidth());
+    writeVector(stream, history.getBuckets());
+}
+
+bool readHistory(std::istream& stream, HistoryStore& history, uint32_t version) {
+    if (version == 1) {
+        std::vector<float> samples;
+        if (!readVector(stream, samples, MAX_VECTOR_ELEMENTS)) return false;
+        history.clear();
+        for (float value : samples) history.push(value);
+        return true;
+    }
+    uint64_t bucketWidth = 0;
+    std::vector<HistoryStore::Bucket> buckets;
+    return readValue(stream, bucketWidth) && readVector(stream, buckets, MAX_VECTOR_ELEMENTS) &&
+           history.restore(bucketWidth, buckets);
+}
+}
+
+std::string TrainingCheckpoint::serialize() const {
+    std::ostringstream stream(std::ios::binary);
+    writeValue(stream, FILE_MAGIC);
+    writeValue(stream, FILE_VERSION);
+    writeValue(stream, generationCount);
+    writeValue(stream, currentMutationRate);
+    writeValue(stream, courseMode);
+    writeValue(stream, currentScenarioId);
+    writeValue(stream, courseSeed);
+    writeValue(stream, scenarioBankSeed);
+    writeValue(stream, convergenceStartGeneration);
+    writeValue(stream, targetReachedGeneration);
+    writeValue(stream, targetReachedSeconds);
+    writeValue(stream, convergenceElapsedSeconds);
+    writeVector(stream, networkStructure);
+    writeVector(stream, eliteGenome);
+    writeValue(stream, static_cast<uint64_t>(populationGenomes.size()));
+    for (const std::vector<float>& genome : populationGenomes) {
+        writeVector(stream, genome);
+    }
+    writeHistory(stream, averageFitnessHistory);
+    writeHistory(stream, bestFitnessHistory);
+    writeHistory(stream, mutationRateHistory);
+    writeValue(stream, static_cast<uint64_t>(rngState.size()));
+    stream.write(rngState.data(), rngState.size());
+    return stream.str();
+}
+
+bool TrainingCheckpoint::saveToFile(const std::string& filename) const {
+    return writeFileAtomic(filename, serialize());
+}
+
+bool TrainingCheckpoint::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    // One read of the whole file; parsing then runs from memory
+    std::istringstream stream(std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()),
+                              std::ios::binary);
+
+    uint32_t magic = 0, version = 0;
+    if (!readValue(stream, magic) || magic != FILE_MAGIC || !readValue(stream, version) || version < 1 || version > FILE_VERSION) {
+        std::cerr << "Warning: " << filename << " is not a compatible training checkpoint." << std::endl;
+        return false;
+    }
+
+    uint64_t populationCount = 0, rngStateSize = 0;
+    bool ok = readValue(stream, generationCount) && readValue(stream, currentMutationRate) &&
+              readValue(stream, courseMode) && readValue(stream, currentScenarioId) &&
+              readValue(stream, courseSeed) && readValue(stream, scenarioBankSeed) &&
+              readValue(stream, convergenceStartGeneration) && readValue(stream, targetReachedGeneration) &&
+              readValue(stream, targetReachedSeconds) && readValue(stream, convergenceElapsedSeconds) &&
+              readVector(stream, networkStructure, MAX_VECTOR_ELEMENTS) &&
+              readVector(stream, eliteGenome, MAX_VECTOR_ELEMENTS) &&
+              readValue(stream, populationCount) && populationCount <= MAX_VECTOR_ELEMENTS;
+    if (ok) {
+        populationGenomes.resize(static_cast<size_t>(populationCount));
+        for (std::vector<float>& genome : populationGenomes) {
+            ok = ok && readVector(stream, genome, MAX_VECTOR_ELEMENTS);
+        }
+    }
+    ok = ok && readHistory(stream, averageFitnessHistory, version) &&
+         readHistory(stream, bestFitnessHistory, version) &&
+         readHistory(stream, mutationRateHistory, version) &&
+         readValue(stream, rngStateSize) && rngStateSize <= MAX_VECTOR_ELEMENTS;
+    if (ok) {
+        rngState.resize(static_cast<size_t>(rngStateSize));
+        ok = static_cast<bool>(stream.read(&rngState[0], rngState.size()));
+    }
+
+    if (!ok) {
+        std::cerr << "Warning: Training checkpoint " << filename << " is truncated or corrupt." << std::endl;
+    }
+    return ok;
+}
@@ -3,10 +3,12 @@
 #include <cmath>
 #include <limits>
 #include <random>
+#include <sstream>
 
-std::mt19937 rng(std::random_device{}());
-std::uniform_real_distribution<float> dist_01(0.0f, 1.0f);
-std::uniform_real_distribution<float> dist_signed(-1.0f, 1.0f);
+// Per-thread engines: genomes are created and mutated on island/evaluation threads too
+thread_local std::mt19937 rng(std::random_device{}());
+thread_local std::uniform_real_distribution<float> dist_01(0.0f, 1.0f);
+thread_local std::uniform_real_distribution<float> dist_signed(-1.0f, 1.0f);
 
 float lerp(float a, float b, float t) {
     return a + (b - a) * t;
@@ -30,6 +32,20 @@ int getRandomInt(int min, int max) {
     return dist(rng);
 }
 
+std::string getRandomState() {
+    std::ostringstream state;
+    state << rng;
+    return state.str();
+}
+
+bool setRandomState(const std::string& state) {
+    std::istringstream input(state);
+    std::mt19937 restored;
+    if (!(input >> restored)) return false;
+    rng = restored;
+    return true;
+}
+
 std::optional<IntersectionData> getIntersection(
     const sf::Vector2f& A, const sf::Vector2f& B,
     const sf::Vector2f& C, const sf::Vector2f& D)
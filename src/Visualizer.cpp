@@ -1,109 +1,176 @@
 #include "Visualizer.hpp"
 #include "Utils.hpp"
 #include <string>
-#include <iostream>
+#include <cmath>
+
+namespace {
+constexpr float NODE_RADIUS = 18.0f;
+constexpr float NODE_OUTLINE_THICKNESS = 2.0f;
+constexpr int CIRCLE_POINTS = 30; // Same as sf::CircleShape
+}
 
 void Visualizer::drawNetwork(sf::RenderTarget& ctx, const NeuralNetwork& network, const sf::Font& font,
                              float x, float y, float width, float height)
 {
-    const float margin = 50.0f;
-    const float left = x + margin;
-    const float top = y + margin;
-    const float drawWidth = width - margin * 2;
-    const float drawHeight = height - margin * 2;
     if (network.levels.empty()) return;
+    const sf::FloatRect area({x, y}, {width, height});
+    if (needsRebuild(network, font, area)) {
+        build(network, font, area);
+    }
+    updateColors(network);
+
+    if (edges.getVertexCount() > 0) ctx.draw(edges);
+    if (nodes.getVertexCount() > 0) ctx.draw(nodes);
+    for (const sf::Text& label : labels) ctx.draw(label);
+}
+
+bool Visualizer::needsRebuild(const NeuralNetwork& network, const sf::Font& font, const sf::FloatRect& area) const {
+    if (builtFont != &font || builtArea.position != area.position || builtArea.size != area.size) return true;
+    if (builtLayerSizes.size() != network.levels.size() + 1) return true;
+    for (size_t i = 0; i < network.levels.size(); ++i) {
+        if (builtLayerSizes[i] != network.levels[i].inputs.size()) return true;
+    }
+    return builtLayerSizes.back() != network.levels.back().outputs.size();
+}
+
+void Visualizer::build(const NeuralNetwork& network, const sf::Font& font, const sf::FloatRect& area) {
+    edges.clear();
+    nodes.clear();
+    colorSlots.clear();
+    labels.clear();
+    builtLayerSizes.clear();
+    for (const Level& level : network.levels) builtLayerSizes.push_back(level.inputs.size());
+    builtLayerSizes.push_back(network.levels.back().outputs.size());
+    builtArea = area;
+    builtFont = &font;
+
+    const float margin = 50.0f;
+    const float left = area.position.x + margin;
+    const float top = area.position.y + margin;
+    const float drawWidth = area.size.x - margin * 2;
+    const float drawHeight = area.size.y - margin * 2;
     const float levelHeight = drawHeight / static_cast<float>(network.levels.size());
+    // Last level first, so the lower levels' nodes end up on top where layers share a row
     for (int i = static_cast<int>(network.levels.size()) - 1; i >= 0; --i) {
         const float levelTop = top + lerp(
             drawHeight - levelHeight,
             0,
             network.levels.size() == 1 ? 0.5f : static_cast<float>(i) / (network.levels.size() - 1)
         );
-        std::vector<std::string> labels;
+        std::vector<std::string> outputLabels;
         if (i == 0) {
-            labels = {"F", "L", "R", "B"};
+            outputLabels = {"F", "L", "R", "B"};
         }
-        Visualizer::drawLevel(ctx, network.levels[i], font,
-                              left, levelTop, drawWidth, levelHeight, labels);
+        buildLevel(static_cast<size_t>(i), network.levels[i], font,
+                   left, levelTop, drawWidth, levelHeight, outputLabels);
     }
 }
 
-void Visualizer::drawLevel(sf::RenderTarget& ctx, const Level& level, const sf::Font& font,
-                           float left, float top, float width, float height,
-                           const std::vector<std::string>& outputLabels)
+void Visualizer::buildLevel(size_t levelIndex, const Level& level, const sf::Font& font,
+                            float left, float top, float width, float height,
+                            const std::vector<std::string>& outputLabels)
 {
     const float right = left + width;
     const float bottom = top + height;
-    const auto& inputs = level.inputs;
-    const auto& outputs = level.outputs;
-    const auto& weights = level.weights;
-    const auto& biases = level.biases;
-    const float nodeRadius = 18.0f;
-    const float lineWidth = 2.0f;
-    const float nodeOutlineThickness = 2.0f;
+    const size_t inputCount = level.inputs.size();
+    const size_t outputCount = level.outputs.size();
 
-    sf::VertexArray lines(sf::PrimitiveType::Lines);
-    for (size_t i = 0; i < inputs.size(); ++i) {
-        float inputX = getNodeX(inputs.size(), i, left, right);
-        for (size_t j = 0; j < outputs.size(); ++j) {
-            float outputX = getNodeX(outputs.size(), j, left, right);
-            sf::Color lineColor = getValueColor(weights[i][j]);
-            lines.append(sf::Vertex{sf::Vector2f(inputX, bottom), lineColor});
-            lines.append(sf::Vertex{sf::Vector2f(outputX, top), lineColor});
+    // Edge colours are written by updateColors in this same input-major order
+    for (size_t i = 0; i < inputCount; ++i) {
+        float inputX = getNodeX(inputCount, i, left, right);
+        for (size_t j = 0; j < outputCount; ++j) {
+            float outputX = getNodeX(outputCount, j, left, right);
+            edges.append(sf::Vertex{sf::Vector2f(inputX, bottom), sf::Color::Transparent});
+            edges.append(sf::Vertex{sf::Vector2f(outputX, top), sf::Color::Transparent});
         }
     }
-    if (lines.getVertexCount() > 0) {
-        ctx.draw(lines);
-    }
 
-    for (size_t i = 0; i < inputs.size(); ++i) {
-        float x = getNodeX(inputs.size(), i, left, right);
-        sf::CircleShape nodeBg(nodeRadius);
-        nodeBg.setFillColor(sf::Color::Black);
-        nodeBg.setOrigin({nodeRadius, nodeRadius});
-        nodeBg.setPosition({x, bottom});
-        ctx.draw(nodeBg);
-        sf::CircleShape nodeValue(nodeRadius * 0.6f);
-        nodeValue.setFillColor(getValueColor(inputs[i]));
-        nodeValue.setOrigin({nodeRadius * 0.6f, nodeRadius * 0.6f});
-        nodeValue.setPosition({x, bottom});
-        ctx.draw(nodeValue);
+    const size_t circleVertices = CIRCLE_POINTS * 3;
+    const size_t ringVertices = CIRCLE_POINTS * 6;
+    for (size_t i = 0; i < inputCount; ++i) {
+        const sf::Vector2f center(getNodeX(inputCount, i, left, right), bottom);
+        appendCircle(center, 0.0f, NODE_RADIUS, sf::Color::Black);
+        const size_t valueStart = appendCircle(center, 0.0f, NODE_RADIUS * 0.6f, sf::Color::Transparent);
+        colorSlots.push_back({valueStart, circleVertices, levelIndex, i, NodeValue::INPUT});
     }
 
-    for (size_t i = 0; i < outputs.size(); ++i) {
-        float x = getNodeX(outputs.size(), i, left, right);
-        sf::CircleShape nodeBg(nodeRadius);
-        nodeBg.setFillColor(sf::Color::Black);
-        nodeBg.setOrigin({nodeRadius, nodeRadius});
-        nodeBg.setPosition({x, top});
-        ctx.draw(nodeBg);
-        sf::CircleShape nodeValue(nodeRadius * 0.6f);
-        nodeValue.setFillColor(getValueColor(outputs[i]));
-        nodeValue.setOrigin({nodeRadius * 0.6f, nodeRadius * 0.6f});
-        nodeValue.setPosition({x, top});
-        ctx.draw(nodeValue);
-        sf::CircleShape biasCircle(nodeRadius * 0.8f);
-        biasCircle.setOutlineThickness(nodeOutlineThickness);
-        biasCircle.setOutlineColor(getValueColor(biases[i]));
-        biasCircle.setFillColor(sf::Color::Transparent);
-        biasCircle.setOrigin({nodeRadius * 0.8f, nodeRadius * 0.8f});
-        biasCircle.setPosition({x, top});
-        ctx.draw(biasCircle);
+    for (size_t i = 0; i < outputCount; ++i) {
+        const sf::Vector2f center(getNodeX(outputCount, i, left, right), top);
+        appendCircle(center, 0.0f, NODE_RADIUS, sf::Color::Black);
+        const size_t valueStart = appendCircle(center, 0.0f, NODE_RADIUS * 0.6f, sf::Color::Transparent);
+        colorSlots.push_back({valueStart, circleVertices, levelIndex, i, NodeValue::OUTPUT});
+        // Outline of the bias circle, which sf::Shape draws outside its radius
+        const size_t biasStart = appendCircle(center, NODE_RADIUS * 0.8f,
+                                              NODE_RADIUS * 0.8f + NODE_OUTLINE_THICKNESS, sf::Color::Transparent);
+        colorSlots.push_back({biasStart, ringVertices, levelIndex, i, NodeValue::BIAS});
+
         if (i < outputLabels.size() && !outputLabels[i].empty()) {
-            sf::Text labelText(font, outputLabels[i], static_cast<unsigned int>(nodeRadius * 1.1));
+            sf::Text labelText(font, outputLabels[i], static_cast<unsigned int>(NODE_RADIUS * 1.1));
             labelText.setFillColor(sf::Color::Black);
             sf::FloatRect textBounds = labelText.getLocalBounds();
             labelText.setOrigin({textBounds.position.x + textBounds.size.x / 2.0f,
                                  textBounds.position.y + textBounds.size.y / 2.0f});
-            labelText.setPosition({x, top});
-            ctx.draw(labelText);
+            labelText.setPosition(center);
+            labels.push_back(labelText);
         }
     }
 }
 
+void Visualizer::updateColors(const NeuralNetwork& network) {
+    size_t vertex = 0;
+    for (int l = static_cast<int>(network.levels.size()) - 1; l >= 0; --l) {
+        const Level& level = network.levels[l];
+        for (size_t i = 0; i < level.weights.size(); ++i) {
+            for (float weight : level.weights[i]) {
+                const sf::Color color = getValueColor(weight);
+                edges[vertex++].color = color;
+                edges[vertex++].color = color;
+            }
+        }
+    }
+
+    for (const ColorSlot& slot : colorSlots) {
+        const Level& level = network.levels[slot.level];
+        const float value = slot.value == NodeValue::INPUT ? level.inputs[slot.index]
+                          : slot.value == NodeValue::OUTPUT ? level.outputs[slot.index]
+                          : level.biases[slot.index];
+        const sf::Color color = getValueColor(value);
+        for (size_t v = slot.firstVertex; v < slot.firstVertex + slot.vertexCount; ++v) {
+            nodes[v].color = color;
+        }
+    }
+}
+
+size_t Visualizer::appendCircle(sf::Vector2f center, float innerRadius, float outerRadius, sf::Color color) {
+    const size_t first = nodes.getVertexCount();
+    auto point = [&](float radius, int step) {
+        const float angle = 2.0f * static_cast<float>(M_PI) * static_cast<float>(step) / CIRCLE_POINTS;
+        return sf::Vector2f(center.x + radius * std::cos(angle), center.y + radius * std::sin(angle));
+    };
+    for (int step = 0; step < CIRCLE_POINTS; ++step) {
+        const sf::Vector2f outerA = point(outerRadius, step);
+        const sf::Vector2f outerB = point(outerRadius, step + 1);
+        if (innerRadius <= 0.0f) {
+            nodes.append(sf::Vertex{center, color});
+            nodes.append(sf::Vertex{outerA, color});
+            nodes.append(sf::Vertex{outerB, color});
+        } else {
+            const sf::Vector2f innerA = point(innerRadius, step);
+            const sf::Vector2f innerB = point(innerRadius, step + 1);
+            nodes.append(sf::Vertex{innerA, color});
+            nodes.append(sf::Vertex{outerA, color});
+            nodes.append(sf::Vertex{outerB, color});
+            nodes.append(sf::Vertex{innerA, color});
+            nodes.append(sf::Vertex{outerB, color});
+            nodes.append(sf::Vertex{innerB, color});
+        }
+    }
+    return first;
+}
+
 float Visualizer::getNodeX(int nodeCount, int index, float left, float right) {
     if (nodeCount <= 1) {
         return lerp(left, right, 0.5f);
     }
     return lerp(left, right, static_cast<float>(index) / (nodeCount - 1));
-}
\ No newline at end of file
+}
@@ -0,0 +1,67 @@
+#include "WorkerPool.hpp"
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t workerCount) {
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        threads.emplace_back(&WorkerPool::workerLoop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(batchMutex);
+        stopping = true;
+    }
+    batchStarted.notify_all();
+    for (std::thread& thread : threads) {
+        if (thread.joinable()) thread.join();
+    }
+}
+
+void WorkerPool::run(size_t taskCount, const Task& task) {
+    if (taskCount == 0) return;
+
+    std::unique_lock<std::mutex> lock(batchMutex);
+    currentTask = &task;
+    currentTaskCount = taskCount;
+    nextTaskIndex.store(0, std::memory_order_relaxed);
+    activeWorkers = threads.size();
+    ++batchId;
+    batchStarted.notify_all();
+
+    batchFinished.wait(lock, [this] { return activeWorkers == 0; });
+    currentTask = nullptr;
+}
+
+void WorkerPool::workerLoop(size_t workerIndex) {
+    size_t seenBatch = 0;
+    while (true) {
+        const Task* task = nullptr;
+        size_t taskCount = 0;
+        {
+            std::unique_lock<std::mutex> lock(batchMutex);
+            batchStarted.wait(lock, [&] { return stopping || batchId != seenBatch; });
+            if (stopping) return;
+            seenBatch = batchId;
+            task = currentTask;
+            taskCount = currentTaskCount;
+        }
+
+        for (size_t index = nextTaskIndex.fetch_add(1, std::memory_order_relaxed);
+             index < taskCount;
+             index = nextTaskIndex.fetch_add(1, std::memory_order_relaxed)) {
+            (*task)(index, workerIndex);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(batchMutex);
+            if (--activeWorkers == 0) {
+                batchFinished.notify_one();
+            }
+        }
+    }
+}
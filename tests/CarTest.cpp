@@ -0,0 +1,63 @@
+#include "Car.hpp"
+#include "Road.hpp"
+#include "TestSupport.hpp"
+#include <vector>
+
+namespace {
+const float TIME_STEP = 1.0f / 60.0f;
+const std::vector<Obstacle*> NO_OBSTACLES;
+
+// Steers across the line between lanes 0 and 1 every time it reaches it, the cheapest way
+// to change lane index as often as possible
+void weave(Car& car, const Road& road) {
+    const float laneLine = road.left + road.width / static_cast<float>(road.laneCount);
+    car.angle = car.position.x < laneLine ? 0.2f : -0.2f;
+}
+
+void testWeavingStaysBelowUpperBound() {
+    const Road road(100.0f, 180.0f, 3);
+    const float laneWidth = road.width / static_cast<float>(road.laneCount);
+    Car weaver(road.left + laneWidth, 0.0f, 30.0f, 50.0f, ControlType::DUMMY);
+
+    for (int tick = 0; tick < 120; ++tick) { // Up to speed first
+        weave(weaver, road);
+        weaver.update(road, NO_OBSTACLES, sf::seconds(TIME_STEP));
+    }
+
+    // Pruning stops a car whose upper bound is below the leaders' guaranteed score. A threshold just
+    // above this bound would stop the weaver now, which is only sound if it can never get past it.
+    const float remainingSeconds = 20.0f;
+    const float prunedThreshold = weaver.getFitnessUpperBound(remainingSeconds, TIME_STEP, laneWidth, 0) + 1.0f;
+    const int ticks = static_cast<int>(remainingSeconds / TIME_STEP);
+    for (int tick = 0; tick < ticks && !weaver.isDamaged(); ++tick) {
+        weave(weaver, road);
+        weaver.update(road, NO_OBSTACLES, sf::seconds(TIME_STEP));
+    }
+    CHECK(!weaver.isDamaged());
+    CHECK(weaver.getFitness() < prunedThreshold);
+}
+
+void testLaneChangeEarnsBonusOnce() {
+    const Road road(100.0f, 180.0f, 3);
+    Car car(road.getLaneCenter(0), 0.0f, 30.0f, 50.0f, ControlType::DUMMY);
+    car.update(road, NO_OBSTACLES, sf::seconds(TIME_STEP));
+
+    // Drift right into the middle of lane 1, then straighten up
+    int bonusTicks = 0;
+    for (int tick = 0; tick < 600; ++tick) {
+        car.angle = car.position.x < road.getLaneCenter(1) ? 0.3f : 0.0f;
+        const float before = car.getFitness();
+        car.update(road, NO_OBSTACLES, sf::seconds(TIME_STEP));
+        if (car.getFitness() - before > 20.0f) bonusTicks++; // Driving earns at most a few points per tick
+    }
+    CHECK(!car.isDamaged());
+    CHECK(car.position.x >= road.getLaneCenter(1));
+    CHECK(bonusTicks == 1);
+}
+}
+
+int main() {
+    testWeavingStaysBelowUpperBound();
+    testLaneChangeEarnsBonusOnce();
+    return testResult("CarTest");
+}
@@ -0,0 +1,52 @@
+#include "EvolutionStrategy.hpp"
+#include "TestSupport.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace {
+bool sameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+void testNoiseIsDeterministic() {
+    // Any worker must rebuild the same candidate from (seed, iteration, candidate, parameter)
+    for (uint64_t parameter = 0; parameter < 1000; ++parameter) {
+        const float first = EvolutionStrategy::noise(7, 3, 11, parameter);
+        CHECK(sameBits(first, EvolutionStrategy::noise(7, 3, 11, parameter)));
+        CHECK(std::isfinite(first));
+    }
+
+    // Changing any one argument gives an unrelated value
+    const float base = EvolutionStrategy::noise(7, 3, 11, 5);
+    CHECK(!sameBits(base, EvolutionStrategy::noise(8, 3, 11, 5)));
+    CHECK(!sameBits(base, EvolutionStrategy::noise(7, 4, 11, 5)));
+    CHECK(!sameBits(base, EvolutionStrategy::noise(7, 3, 12, 5)));
+    CHECK(!sameBits(base, EvolutionStrategy::noise(7, 3, 11, 6)));
+}
+
+void testNoiseIsStandardNormal() {
+    const int sampleCount = 200000;
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    int beyondTwoSigma = 0;
+    for (int i = 0; i < sampleCount; ++i) {
+        const double value = EvolutionStrategy::noise(1, static_cast<uint64_t>(i / 1000), static_cast<uint64_t>(i % 7),
+                                                      static_cast<uint64_t>(i));
+        sum += value;
+        sumSquares += value * value;
+        if (std::abs(value) > 2.0) beyondTwoSigma++;
+    }
+    const double mean = sum / sampleCount;
+    const double variance = sumSquares / sampleCount - mean * mean;
+    CHECK(std::abs(mean) < 0.01);
+    CHECK(std::abs(variance - 1.0) < 0.02);
+    const double tailShare = static_cast<double>(beyondTwoSigma) / sampleCount;
+    CHECK(std::abs(tailShare - 0.0455) < 0.003);
+}
+}
+
+int main() {
+    testNoiseIsDeterministic();
+    testNoiseIsStandardNormal();
+    return testResult("EvolutionStrategyTest");
+}
@@ -0,0 +1,110 @@
+#include "GenerationPreparer.hpp"
+#include "TestSupport.hpp"
+#include <chrono>
+#include <thread>
+
+namespace {
+const std::vector<int> STRUCTURE = {5, 6, 4};
+
+// take() gives up on a request the worker has not started, so the tests let each build finish
+// first. Building a few networks this small takes microseconds.
+void waitForBuild() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+}
+
+void testTakeHandsOverMatchingBuild() {
+    GenerationPreparer preparer;
+    const NeuralNetwork parent(STRUCTURE);
+    preparer.prepare(parent, 0.2f, 8);
+    waitForBuild();
+
+    std::vector<NeuralNetwork> offspring;
+    std::vector<uint64_t> hashes;
+    CHECK(preparer.take(parent, 0.2f, offspring, hashes));
+    CHECK(offspring.size() == 8);
+    CHECK(hashes.size() == 8);
+    for (size_t i = 0; i < offspring.size() && i < hashes.size(); ++i) {
+        CHECK(hashes[i] == offspring[i].getGenomeHash());
+        CHECK(!offspring[i].sameGenome(parent)); // Mutated
+    }
+    CHECK(preparer.getHits() == 1);
+    CHECK(preparer.getMisses() == 0);
+
+    // The buffer is handed over once
+    CHECK(!preparer.take(parent, 0.2f, offspring, hashes));
+    CHECK(preparer.getMisses() == 1);
+}
+
+void testOtherParentOrRateMisses() {
+    GenerationPreparer preparer;
+    const NeuralNetwork parent(STRUCTURE);
+    const NeuralNetwork otherParent(STRUCTURE);
+    preparer.prepare(parent, 0.2f, 4);
+    waitForBuild();
+
+    std::vector<NeuralNetwork> offspring;
+    std::vector<uint64_t> hashes;
+    CHECK(!preparer.take(parent, 0.3f, offspring, hashes));
+    CHECK(!preparer.take(otherParent, 0.2f, offspring, hashes));
+    CHECK(offspring.empty());
+    // A miss leaves the buffer for the request it was built for
+    CHECK(preparer.take(parent, 0.2f, offspring, hashes));
+    CHECK(offspring.size() == 4);
+    CHECK(preparer.getHits() == 1);
+    CHECK(preparer.getMisses() == 2);
+}
+
+void testNewerRequestReplacesOlder() {
+    GenerationPreparer preparer;
+    const NeuralNetwork firstGuess(STRUCTURE);
+    const NeuralNetwork secondGuess(STRUCTURE);
+    // Rate 0 leaves each offspring an exact copy of its parent, so the test can tell the builds apart
+    preparer.prepare(firstGuess, 0.0f, 4);
+    preparer.prepare(secondGuess, 0.0f, 4);
+    waitForBuild();
+
+    std::vector<NeuralNetwork> offspring;
+    std::vector<uint64_t> hashes;
+    CHECK(preparer.take(secondGuess, 0.0f, offspring, hashes));
+    CHECK(offspring.size() == 4);
+    for (const NeuralNetwork& child : offspring) {
+        CHECK(child.sameGenome(secondGuess));
+    }
+    CHECK(!preparer.take(firstGuess, 0.0f, offspring, hashes));
+    CHECK(preparer.getHits() == 1);
+    CHECK(preparer.getMisses() == 1);
+}
+
+void testBredBufferNeedsSamePoolAndSelection() {
+    GenerationPreparer preparer;
+    const std::vector<NeuralNetwork> pool = {NeuralNetwork(STRUCTURE), NeuralNetwork(STRUCTURE), NeuralNetwork(STRUCTURE)};
+    const std::vector<float> fitness = {3.0f, 2.0f, 1.0f};
+    const SelectionSettings selection = multiParentSelection(CrossoverMode::UNIFORM);
+    preparer.prepareBred(pool, fitness, 0.2f, selection, 8);
+    waitForBuild();
+
+    std::vector<NeuralNetwork> offspring;
+    std::vector<uint64_t> hashes;
+    const std::vector<NeuralNetwork> reordered = {pool[0], pool[2], pool[1]};
+    CHECK(!preparer.takeBred(reordered, 0.2f, selection, offspring, hashes));
+    CHECK(!preparer.takeBred(pool, 0.2f, multiParentSelection(CrossoverMode::LAYER_WISE), offspring, hashes));
+    CHECK(preparer.takeBred(pool, 0.2f, selection, offspring, hashes));
+    CHECK(offspring.size() == 8);
+    CHECK(hashes.size() == 8);
+    // The best parent's own slot is left out, so the second elite comes first
+    if (!offspring.empty()) CHECK(offspring[0].sameGenome(pool[1]));
+    for (size_t i = 0; i < offspring.size() && i < hashes.size(); ++i) {
+        CHECK(hashes[i] == offspring[i].getGenomeHash());
+    }
+    CHECK(preparer.getHits() == 1);
+    CHECK(preparer.getMisses() == 2);
+}
+}
+
+int main() {
+    testTakeHandsOverMatchingBuild();
+    testOtherParentOrRateMisses();
+    testNewerRequestReplacesOlder();
+    testBredBufferNeedsSamePoolAndSelection();
+    return testResult("GenerationPreparerTest");
+}
@@ -0,0 +1,102 @@
+#include "HistoryStore.hpp"
+#include "TestSupport.hpp"
+
+namespace {
+bool sameBuckets(const HistoryStore& a, const HistoryStore& b) {
+    if (a.getBucketWidth() != b.getBucketWidth() || a.getSampleCount() != b.getSampleCount() ||
+        a.getBuckets().size() != b.getBuckets().size() || a.getMin() != b.getMin() || a.getMax() != b.getMax()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.getBuckets().size(); ++i) {
+        const HistoryStore::Bucket& p = a.getBuckets()[i];
+        const HistoryStore::Bucket& q = b.getBuckets()[i];
+        if (p.min != q.min || p.max != q.max || p.sum != q.sum || p.count != q.count) return false;
+    }
+    return true;
+}
+
+void testMerging() {
+    HistoryStore history(8);
+    CHECK(history.empty());
+    const int sampleCount = 1000;
+    for (int i = 1; i <= sampleCount; ++i) {
+        history.push(static_cast<float>(i));
+
+        const std::vector<HistoryStore::Bucket>& buckets = history.getBuckets();
+        CHECK(buckets.size() <= 8);
+        for (size_t b = 0; b + 1 < buckets.size(); ++b) {
+            CHECK(buckets[b].count == history.getBucketWidth());
+        }
+        CHECK(!buckets.empty() && buckets.back().count >= 1 && buckets.back().count <= history.getBucketWidth());
+    }
+
+    CHECK(history.getSampleCount() == static_cast<uint64_t>(sampleCount));
+    CHECK(history.getBucketWidth() == 128); // 1000 samples in at most 8 buckets
+    CHECK(history.getMin() == 1.0f);
+    CHECK(history.getMax() == static_cast<float>(sampleCount));
+
+    uint64_t count = 0;
+    double sum = 0.0;
+    float previousMax = 0.0f;
+    for (const HistoryStore::Bucket& bucket : history.getBuckets()) {
+        count += bucket.count;
+        sum += bucket.sum;
+        CHECK(bucket.min > previousMax); // Buckets cover consecutive generations in order
+        CHECK(bucket.max - bucket.min == static_cast<float>(bucket.count - 1));
+        previousMax = bucket.max;
+    }
+    CHECK(count == static_cast<uint64_t>(sampleCount));
+    CHECK(sum == sampleCount * (sampleCount + 1) / 2.0);
+
+    history.clear();
+    CHECK(history.empty() && history.getBuckets().empty() && history.getBucketWidth() == 1);
+}
+
+void testRestore() {
+    HistoryStore original(16);
+    for (int i = 0; i < 300; ++i) original.push(static_cast<float>((i * 37) % 101));
+
+    HistoryStore restored(16);
+    CHECK(restored.restore(original.getBucketWidth(), original.getBuckets()));
+    CHECK(sameBuckets(original, restored));
+
+    // A restored store continues exactly like the original, merges included
+    for (int i = 0; i < 700; ++i) {
+        const float value = static_cast<float>(i % 13);
+        original.push(value);
+        restored.push(value);
+    }
+    CHECK(sameBuckets(original, restored));
+}
+
+void testRestoreRejectsInconsistentState() {
+    const std::vector<HistoryStore::Bucket> valid = {{1.0f, 2.0f, 3.0, 2}, {3.0f, 3.0f, 3.0, 1}};
+    HistoryStore history(4);
+    CHECK(history.restore(2, valid));
+    CHECK(history.getSampleCount() == 3);
+
+    CHECK(!history.restore(0, valid));
+    CHECK(history.empty());
+
+    const std::vector<HistoryStore::Bucket> shortMiddle = {{1.0f, 1.0f, 1.0, 1}, {2.0f, 3.0f, 5.0, 2}};
+    CHECK(!history.restore(2, shortMiddle));
+    CHECK(history.empty());
+
+    const std::vector<HistoryStore::Bucket> emptyBucket = {{0.0f, 0.0f, 0.0, 0}};
+    CHECK(!history.restore(1, emptyBucket));
+
+    const std::vector<HistoryStore::Bucket> overfull = {{1.0f, 4.0f, 10.0, 4}};
+    CHECK(!history.restore(2, overfull));
+
+    const std::vector<HistoryStore::Bucket> tooMany(5, HistoryStore::Bucket{1.0f, 1.0f, 1.0, 1});
+    CHECK(!history.restore(1, tooMany));
+    CHECK(history.empty());
+}
+}
+
+int main() {
+    testMerging();
+    testRestore();
+    testRestoreRejectsInconsistentState();
+    return testResult("HistoryStoreTest");
+}
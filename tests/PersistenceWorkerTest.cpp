@@ -0,0 +1,95 @@
+#include "PersistenceWorker.hpp"
+#include "TestSupport.hpp"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <string>
+
+namespace {
+const std::string FIRST_FILE = "persistence_worker_test_a.txt";
+const std::string SECOND_FILE = "persistence_worker_test_b.txt";
+
+std::string readFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// A save whose serializer holds the worker until 'release' is set, so the test can queue
+// more saves behind a write that is known to be in progress
+PersistenceWorker::Serializer heldSave(std::shared_future<void> release, std::promise<void>& started, std::string contents) {
+    return [release, &started, contents]() {
+        started.set_value();
+        release.wait();
+        return contents;
+    };
+}
+
+void testNewestSaveWins() {
+    std::promise<void> release;
+    std::promise<void> started;
+    std::atomic<int> serialized{0};
+    PersistenceWorker worker;
+
+    worker.save(FIRST_FILE, heldSave(release.get_future().share(), started, "held"));
+    started.get_future().wait();
+    // Three saves of one file while the worker is busy: only the newest is serialized
+    for (int version = 1; version <= 3; ++version) {
+        worker.save(SECOND_FILE, [&serialized, version]() {
+            serialized++;
+            return "version " + std::to_string(version);
+        });
+    }
+    CHECK(worker.getSavesCoalesced() == 2);
+    release.set_value();
+    worker.flush();
+
+    CHECK(serialized == 1);
+    CHECK(worker.getWritesCompleted() == 2);
+    CHECK(readFile(FIRST_FILE) == "held");
+    CHECK(readFile(SECOND_FILE) == "version 3");
+}
+
+void testSaveDuringWriteIsWrittenAfterIt() {
+    std::promise<void> release;
+    std::promise<void> started;
+    PersistenceWorker worker;
+
+    // The file is being written when the newer save arrives; the newer one must land last
+    worker.save(FIRST_FILE, heldSave(release.get_future().share(), started, "older"));
+    started.get_future().wait();
+    worker.save(FIRST_FILE, []() { return std::string("newer"); });
+    CHECK(worker.getSavesCoalesced() == 0); // Nothing was pending for it
+    release.set_value();
+    worker.flush();
+
+    CHECK(worker.getWritesCompleted() == 2);
+    CHECK(readFile(FIRST_FILE) == "newer");
+}
+
+void testFlushAndShutdownWriteEverything() {
+    {
+        PersistenceWorker worker;
+        worker.flush(); // Nothing queued: returns at once
+        CHECK(worker.getWritesCompleted() == 0);
+
+        worker.save(FIRST_FILE, []() { return std::string("flushed"); });
+        worker.flush();
+        CHECK(worker.getWritesCompleted() == 1);
+        CHECK(readFile(FIRST_FILE) == "flushed");
+
+        worker.save(SECOND_FILE, []() { return std::string("written on shutdown"); });
+    }
+    CHECK(readFile(SECOND_FILE) == "written on shutdown");
+}
+}
+
+int main() {
+    testNewestSaveWins();
+    testSaveDuringWriteIsWrittenAfterIt();
+    testFlushAndShutdownWriteEverything();
+    std::remove(FIRST_FILE.c_str());
+    std::remove(SECOND_FILE.c_str());
+    return testResult("PersistenceWorkerTest");
+}
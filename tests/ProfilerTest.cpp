@@ -0,0 +1,105 @@
+#include "Profiler.hpp"
+#include "TestSupport.hpp"
+#include <algorithm>
+#include <random>
+#include <string>
+
+namespace {
+const size_t SENSORS = static_cast<size_t>(ProfilePhase::SENSORS);
+const size_t RENDER_WORLD = static_cast<size_t>(ProfilePhase::RENDER_WORLD);
+
+size_t countOf(const std::string& text, const std::string& part) {
+    size_t count = 0;
+    for (size_t at = text.find(part); at != std::string::npos; at = text.find(part, at + part.size())) ++count;
+    return count;
+}
+
+void testStatsPercentiles() {
+    CHECK(Profiler::statsOf({}, Profiler::TOTAL).p99 == 0.0f);
+
+    // 1..100 ms in shuffled order: nearest rank puts p50 at 51 and p99 at 99
+    std::vector<Profiler::Frame> frames(100);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        frames[i].phaseMs[SENSORS] = static_cast<float>(i + 1);
+        frames[i].totalMs = 2.0f * static_cast<float>(i + 1);
+    }
+    std::shuffle(frames.begin(), frames.end(), std::mt19937(7));
+    const Profiler::Stats sensors = Profiler::statsOf(frames, SENSORS);
+    CHECK(sensors.p50 == 51.0f);
+    CHECK(sensors.p99 == 99.0f);
+    CHECK(sensors.mean == 50.5f);
+    const Profiler::Stats total = Profiler::statsOf(frames, Profiler::TOTAL);
+    CHECK(total.p50 == 102.0f);
+    CHECK(total.p99 == 198.0f);
+    CHECK(total.mean == 101.0f);
+
+    const Profiler::Stats single = Profiler::statsOf({frames.front()}, SENSORS);
+    CHECK(single.p50 == frames.front().phaseMs[SENSORS]);
+    CHECK(single.p99 == single.p50);
+    CHECK(single.mean == single.p50);
+}
+
+void testRingKeepsNewestFramesOldestFirst() {
+    Profiler& profiler = Profiler::instance();
+    profiler.attachThread(ProfileTrack::RENDER);
+    profiler.endFrame(); // No frame begun: ignored
+    const size_t frameCount = Profiler::FRAME_CAPACITY + 25;
+    for (size_t i = 0; i < frameCount; ++i) {
+        profiler.beginFrame();
+        profiler.add(ProfilePhase::RENDER_WORLD, static_cast<float>(i));
+        profiler.endFrame();
+    }
+    profiler.detachThread();
+    profiler.add(ProfilePhase::RENDER_WORLD, 1.0f); // Detached: nowhere to record
+
+    const Profiler::Recording recording = profiler.getRecording();
+    CHECK(recording[static_cast<size_t>(ProfileTrack::SIMULATION)].empty());
+    const std::vector<Profiler::Frame>& frames = recording[static_cast<size_t>(ProfileTrack::RENDER)];
+    CHECK(frames.size() == Profiler::FRAME_CAPACITY);
+    bool inOrder = true;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const size_t expected = frameCount - Profiler::FRAME_CAPACITY + i;
+        inOrder = inOrder && frames[i].number == expected && frames[i].phaseMs[RENDER_WORLD] == static_cast<float>(expected);
+    }
+    CHECK(inOrder);
+}
+
+void testCsvAndJson() {
+    Profiler::Recording recording;
+    Profiler::Frame frame;
+    frame.number = 7;
+    frame.totalMs = 1.5f;
+    frame.phaseMs[SENSORS] = 0.25f;
+    recording[static_cast<size_t>(ProfileTrack::SIMULATION)].push_back(frame);
+
+    const std::string csv = Profiler::toCsv(recording);
+    const std::string header = csv.substr(0, csv.find('\n'));
+    CHECK(header.rfind("track,frame,total_ms,sensors_ms,controls_ms", 0) == 0);
+    CHECK(countOf(header, ",") == Profiler::PHASE_COUNT + 2);
+    CHECK(countOf(csv, "\n") == 2); // Header and the one frame
+    CHECK(csv.find("\nsimulation,7,1.5000,0.2500,0.0000,") != std::string::npos);
+
+    const std::string json = Profiler::toJson(recording);
+    const size_t renderStart = json.find("\"render\": {");
+    CHECK(json.find("\"simulation\": {") < renderStart);
+    CHECK(renderStart != std::string::npos);
+    const std::string simulation = json.substr(0, renderStart);
+    const std::string render = json.substr(renderStart);
+    CHECK(simulation.find("\"frames\": 1,") != std::string::npos);
+    CHECK(simulation.find("\"total\": {\"p50_ms\": 1.5000, \"p99_ms\": 1.5000, \"mean_ms\": 1.5000}") != std::string::npos);
+    CHECK(simulation.find("\"sensors\": {\"p50_ms\": 0.2500") != std::string::npos);
+    // Each phase is listed under the track that records it
+    CHECK(simulation.find("\"render_world\"") == std::string::npos);
+    CHECK(render.find("\"frames\": 0,") != std::string::npos);
+    CHECK(render.find("\"render_world\": {\"p50_ms\": 0.0000") != std::string::npos);
+    CHECK(render.find("\"sensors\"") == std::string::npos);
+    CHECK(countOf(json, "{") == countOf(json, "}"));
+}
+}
+
+int main() {
+    testStatsPercentiles();
+    testRingKeepsNewestFramesOldestFirst();
+    testCsvAndJson();
+    return testResult("ProfilerTest");
+}
@@ -0,0 +1,130 @@
+#include "ScenarioBank.hpp"
+#include "TestSupport.hpp"
+#include <fstream>
+#include <cstring>
+#include <string>
+
+namespace {
+const CourseLayout COURSE = {{20.0f, 40.0f, 40.0f, 80.0f, 75.0f, 150.0f}, 1000.0f, -100.0f, 12};
+const std::string FILENAME = "scenario_bank_test.dat";
+
+// Header: magic, version, lanes, road left/width, chunk length, start Y, obstacles per chunk, layout
+constexpr size_t SCENARIO_COUNT_OFFSET = 8 * 4 + sizeof(ObstacleLayout);
+constexpr size_t FIRST_CHUNK_COUNT_OFFSET = SCENARIO_COUNT_OFFSET + 4 + 4 + 8;
+constexpr size_t FIRST_SPEC_COUNT_OFFSET = FIRST_CHUNK_COUNT_OFFSET + 4;
+
+void writeRaw(const std::string& contents) {
+    std::ofstream file(FILENAME, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+void patchUint32(std::string& contents, size_t offset, uint32_t value) {
+    std::memcpy(&contents[offset], &value, sizeof(value));
+}
+
+bool sameScenarios(const ScenarioBank& a, const ScenarioBank& b) {
+    if (a.size() != b.size()) return false;
+    for (uint32_t id = 0; id < a.size(); ++id) {
+        const Scenario& left = a.get(id);
+        const Scenario& right = b.get(id);
+        if (left.id != right.id || left.seed != right.seed || left.chunks.size() != right.chunks.size()) return false;
+        for (size_t c = 0; c < left.chunks.size(); ++c) {
+            if (left.chunks[c].size() != right.chunks[c].size()) return false;
+            for (size_t i = 0; i < left.chunks[c].size(); ++i) {
+                const ObstacleSpec& p = left.chunks[c][i];
+                const ObstacleSpec& q = right.chunks[c][i];
+                if (p.x != q.x || p.y != q.y || p.width != q.width || p.height != q.height || p.lane != q.lane) return false;
+            }
+        }
+    }
+    return true;
+}
+
+void testRoundTrip() {
+    ScenarioBank bank(0.0f, 300.0f, 3, COURSE);
+    bank.generate(4, 3, 7);
+    CHECK(bank.size() == 4);
+    CHECK(bank.saveToFile(FILENAME));
+
+    ScenarioBank loaded(0.0f, 300.0f, 3, COURSE);
+    CHECK(loaded.loadFromFile(FILENAME));
+    CHECK(sameScenarios(bank, loaded));
+
+    // Generation is deterministic in the seed
+    ScenarioBank again(0.0f, 300.0f, 3, COURSE);
+    again.generate(4, 3, 7);
+    CHECK(sameScenarios(bank, again));
+}
+
+void testLayoutMismatch() {
+    ScenarioBank bank(0.0f, 300.0f, 3, COURSE);
+    bank.generate(2, 2, 7);
+    CHECK(bank.saveToFile(FILENAME));
+
+    CourseLayout denser = COURSE;
+    denser.obstaclesPerChunk = COURSE.obstaclesPerChunk + 1;
+    ScenarioBank otherCount(0.0f, 300.0f, 3, denser);
+    CHECK(!otherCount.loadFromFile(FILENAME));
+
+    CourseLayout wider = COURSE;
+    wider.obstacles.maxWidth += 1.0f;
+    ScenarioBank otherLayout(0.0f, 300.0f, 3, wider);
+    CHECK(!otherLayout.loadFromFile(FILENAME));
+
+    ScenarioBank otherRoad(0.0f, 300.0f, 4, COURSE);
+    CHECK(!otherRoad.loadFromFile(FILENAME));
+}
+
+void testCorruptInput() {
+    ScenarioBank bank(0.0f, 300.0f, 3, COURSE);
+    bank.generate(3, 2, 11);
+    const std::string contents = bank.serialize();
+    CHECK(contents.size() > FIRST_SPEC_COUNT_OFFSET + 4);
+
+    ScenarioBank target(0.0f, 300.0f, 3, COURSE);
+    target.generate(1, 1, 5);
+    const ScenarioBank before = target;
+
+    // Every truncation fails and leaves the bank as it was
+    for (size_t length = 0; length < contents.size(); length += 13) {
+        writeRaw(contents.substr(0, length));
+        CHECK(!target.loadFromFile(FILENAME));
+    }
+    CHECK(sameScenarios(target, before));
+
+    std::string corrupt = contents;
+    corrupt[0] ^= 0x01;
+    writeRaw(corrupt);
+    CHECK(!target.loadFromFile(FILENAME));
+
+    // Counts larger than the file could hold are rejected before allocating
+    corrupt = contents;
+    patchUint32(corrupt, SCENARIO_COUNT_OFFSET, 0xFFFFFFFFu);
+    writeRaw(corrupt);
+    CHECK(!target.loadFromFile(FILENAME));
+
+    corrupt = contents;
+    patchUint32(corrupt, FIRST_CHUNK_COUNT_OFFSET, 0xFFFFFFFFu);
+    writeRaw(corrupt);
+    CHECK(!target.loadFromFile(FILENAME));
+
+    corrupt = contents;
+    patchUint32(corrupt, FIRST_SPEC_COUNT_OFFSET, static_cast<uint32_t>(COURSE.obstaclesPerChunk + 1));
+    writeRaw(corrupt);
+    CHECK(!target.loadFromFile(FILENAME));
+
+    CHECK(sameScenarios(target, before));
+
+    writeRaw(contents);
+    CHECK(target.loadFromFile(FILENAME));
+    CHECK(sameScenarios(target, bank));
+}
+}
+
+int main() {
+    testRoundTrip();
+    testLayoutMismatch();
+    testCorruptInput();
+    std::remove(FILENAME.c_str());
+    return testResult("ScenarioBankTest");
+}
@@ -0,0 +1,107 @@
+#include "Selection.hpp"
+#include "TestSupport.hpp"
+#include <algorithm>
+
+namespace {
+const std::vector<int> STRUCTURE = {5, 6, 4};
+
+std::vector<NeuralNetwork> makePopulation(size_t count) {
+    std::vector<NeuralNetwork> population;
+    for (size_t i = 0; i < count; ++i) population.emplace_back(STRUCTURE);
+    return population;
+}
+
+// Distinct fitness values in a shuffled order, so the best cars are not simply the first ones
+std::vector<float> makeFitness(size_t count) {
+    std::vector<float> fitness(count);
+    for (size_t i = 0; i < count; ++i) fitness[i] = static_cast<float>((i * 7919) % count) * 10.0f - 50.0f;
+    return fitness;
+}
+
+void testSelectTopIndices() {
+    const std::vector<float> fitness = {3.0f, -1.0f, 8.0f, 5.0f, 0.0f};
+    const std::vector<size_t> top = selectTopIndices(fitness, 3);
+    CHECK((top == std::vector<size_t>{2, 3, 0}));
+    CHECK(selectTopIndices(fitness, 10).size() == fitness.size());
+    CHECK(selectTopIndices({}, 3).empty());
+}
+
+void testTournamentStaysInPool() {
+    const std::vector<float> fitness = makeFitness(40);
+    const std::vector<size_t> pool = selectTopIndices(fitness, 8);
+    for (int round = 0; round < 500; ++round) {
+        const size_t winner = tournamentSelect(pool, fitness, 3);
+        CHECK(std::find(pool.begin(), pool.end(), winner) != pool.end());
+    }
+    // A tournament over the whole pool with replacement still never beats the best
+    const size_t best = pool.front();
+    for (int round = 0; round < 100; ++round) {
+        CHECK(fitness[tournamentSelect(pool, fitness, 50)] <= fitness[best]);
+    }
+}
+
+void checkElites(const SelectionSettings& settings) {
+    const size_t count = 40;
+    const std::vector<NeuralNetwork> parents = makePopulation(count);
+    const std::vector<float> fitness = makeFitness(count);
+    std::vector<NeuralNetwork> offspring = makePopulation(count);
+
+    breedGeneration(parents, fitness, 0.3f, settings, offspring);
+
+    CHECK(offspring.size() == count);
+    const size_t eliteCount = static_cast<size_t>(std::max(1, settings.eliteCount));
+    const std::vector<size_t> ranking = selectTopIndices(fitness, eliteCount);
+    for (size_t i = 0; i < eliteCount; ++i) {
+        // Elites are the best parents in rank order, bit for bit unchanged
+        CHECK(offspring[i].getGenomeHash() == parents[ranking[i]].getGenomeHash());
+        CHECK(offspring[i].toGenome() == parents[ranking[i]].toGenome());
+        CHECK(offspring[i].sameGenome(parents[ranking[i]]));
+    }
+    for (size_t i = eliteCount; i < count; ++i) {
+        CHECK(!offspring[i].sameGenome(parents[ranking[0]])); // Mutated children differ from the best parent
+    }
+    for (const NeuralNetwork& child : offspring) {
+        CHECK(child.getGenomeSize() == parents.front().getGenomeSize());
+    }
+}
+
+void testBreedKeepsElites() {
+    checkElites(SelectionSettings());
+    checkElites(multiParentSelection(CrossoverMode::NONE));
+    checkElites(multiParentSelection(CrossoverMode::UNIFORM));
+    checkElites(multiParentSelection(CrossoverMode::LAYER_WISE));
+}
+
+void testZeroRateCrossoverOnlyMixesParents() {
+    const size_t count = 20;
+    const std::vector<NeuralNetwork> parents = makePopulation(count);
+    const std::vector<float> fitness = makeFitness(count);
+    std::vector<NeuralNetwork> offspring = makePopulation(count);
+
+    SelectionSettings settings = multiParentSelection(CrossoverMode::UNIFORM);
+    settings.matingPoolSize = 4;
+    settings.crossoverFraction = 1.0f;
+    breedGeneration(parents, fitness, 0.0f, settings, offspring);
+
+    // Without mutation every gene of a child comes from one of the mating pool's parents
+    const std::vector<size_t> pool = selectTopIndices(fitness, 4);
+    for (size_t i = static_cast<size_t>(settings.eliteCount); i < count; ++i) {
+        const std::vector<float> child = offspring[i].toGenome();
+        for (size_t gene = 0; gene < child.size(); ++gene) {
+            bool fromPool = false;
+            for (size_t parent : pool) {
+                fromPool = fromPool || parents[parent].toGenome()[gene] == child[gene];
+            }
+            CHECK(fromPool);
+        }
+    }
+}
+}
+
+int main() {
+    testSelectTopIndices();
+    testTournamentStaysInPool();
+    testBreedKeepsElites();
+    testZeroRateCrossoverOnlyMixesParents();
+    return testResult("SelectionTest");
+}
@@ -0,0 +1,30 @@
+#ifndef TEST_SUPPORT_HPP
+#define TEST_SUPPORT_HPP
+
+#include <iostream>
+
+// Minimal checks for the ctest executables: a failed CHECK is reported with its location
+// and the test keeps going; main() returns testResult() so any failure fails the test.
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                          \
+    do {                                                                                          \
+        if (!(condition)) {                                                                       \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" << std::endl; \
+            ++testFailures();                                                                     \
+        }                                                                                         \
+    } while (0)
+
+inline int testResult(const char* name) {
+    if (testFailures() == 0) {
+        std::cout << name << ": all checks passed" << std::endl;
+        return 0;
+    }
+    std::cerr << name << ": " << testFailures() << " check(s) failed" << std::endl;
+    return 1;
+}
+
+#endif // TEST_SUPPORT_HPP
@@ -0,0 +1,159 @@
+#include "TrainingCheckpoint.hpp"
+#include "Network.hpp"
+#include "Utils.hpp"
+#include "TestSupport.hpp"
+#include <fstream>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace {
+const std::string FILENAME = "training_checkpoint_test.dat";
+
+// Magic, version, then the fixed-size counters before the first vector's length
+constexpr size_t NETWORK_STRUCTURE_OFFSET = 4 + 4 + 4 + 4 + 4 + 4 + 8 + 8 + 4 + 4 + 4 + 4;
+
+void writeRaw(const std::string& contents) {
+    std::ofstream file(FILENAME, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+bool sameHistory(const HistoryStore& a, const HistoryStore& b) {
+    if (a.getBucketWidth() != b.getBucketWidth() || a.getSampleCount() != b.getSampleCount() ||
+        a.getBuckets().size() != b.getBuckets().size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.getBuckets().size(); ++i) {
+        const HistoryStore::Bucket& p = a.getBuckets()[i];
+        const HistoryStore::Bucket& q = b.getBuckets()[i];
+        if (p.min != q.min || p.max != q.max || p.sum != q.sum || p.count != q.count) return false;
+    }
+    return true;
+}
+
+TrainingCheckpoint makeCheckpoint() {
+    TrainingCheckpoint checkpoint;
+    checkpoint.generationCount = 42;
+    checkpoint.currentMutationRate = 0.125f;
+    checkpoint.courseMode = 1;
+    checkpoint.currentScenarioId = 3;
+    checkpoint.courseSeed = 0x0123456789ABCDEFull;
+    checkpoint.scenarioBankSeed = 20240601;
+    checkpoint.convergenceStartGeneration = 5;
+    checkpoint.targetReachedGeneration = -1;
+    checkpoint.targetReachedSeconds = 0.0f;
+    checkpoint.convergenceElapsedSeconds = 812.5f;
+    checkpoint.networkStructure = {5, 6, 4};
+    for (int i = 0; i < 58; ++i) checkpoint.eliteGenome.push_back(0.01f * i - 0.3f);
+    for (int car = 0; car < 7; ++car) {
+        std::vector<float> genome = checkpoint.eliteGenome;
+        for (float& value : genome) value += 0.001f * car;
+        checkpoint.populationGenomes.push_back(genome);
+    }
+    for (int generation = 0; generation < 1000; ++generation) { // Enough to merge buckets
+        checkpoint.averageFitnessHistory.push(static_cast<float>(generation));
+        checkpoint.bestFitnessHistory.push(static_cast<float>(generation * 2 % 97));
+    }
+    checkpoint.mutationRateHistory.push(0.5f);
+    checkpoint.rngState = "1 2 3 4 5";
+    return checkpoint;
+}
+
+void testRoundTrip() {
+    const TrainingCheckpoint saved = makeCheckpoint();
+    CHECK(saved.saveToFile(FILENAME));
+
+    TrainingCheckpoint loaded;
+    CHECK(loaded.loadFromFile(FILENAME));
+    CHECK(loaded.generationCount == saved.generationCount);
+    CHECK(loaded.currentMutationRate == saved.currentMutationRate);
+    CHECK(loaded.courseMode == saved.courseMode);
+    CHECK(loaded.currentScenarioId == saved.currentScenarioId);
+    CHECK(loaded.courseSeed == saved.courseSeed);
+    CHECK(loaded.scenarioBankSeed == saved.scenarioBankSeed);
+    CHECK(loaded.convergenceStartGeneration == saved.convergenceStartGeneration);
+    CHECK(loaded.targetReachedGeneration == saved.targetReachedGeneration);
+    CHECK(loaded.targetReachedSeconds == saved.targetReachedSeconds);
+    CHECK(loaded.convergenceElapsedSeconds == saved.convergenceElapsedSeconds);
+    CHECK(loaded.networkStructure == saved.networkStructure);
+    CHECK(loaded.eliteGenome == saved.eliteGenome);
+    CHECK(loaded.populationGenomes == saved.populationGenomes);
+    CHECK(sameHistory(loaded.averageFitnessHistory, saved.averageFitnessHistory));
+    CHECK(sameHistory(loaded.bestFitnessHistory, saved.bestFitnessHistory));
+    CHECK(sameHistory(loaded.mutationRateHistory, saved.mutationRateHistory));
+    CHECK(loaded.rngState == saved.rngState);
+    CHECK(loaded.serialize() == saved.serialize());
+}
+
+void testCorruptInput() {
+    const std::string contents = makeCheckpoint().serialize();
+    TrainingCheckpoint loaded;
+
+    for (size_t length = 0; length < contents.size(); length += 97) {
+        writeRaw(contents.substr(0, length));
+        CHECK(!loaded.loadFromFile(FILENAME));
+    }
+    writeRaw(contents.substr(0, contents.size() - 1));
+    CHECK(!loaded.loadFromFile(FILENAME));
+
+    std::string corrupt = contents;
+    corrupt[0] ^= 0x01;
+    writeRaw(corrupt);
+    CHECK(!loaded.loadFromFile(FILENAME));
+
+    // A huge vector length is rejected instead of allocated
+    corrupt = contents;
+    const uint64_t hugeCount = 1ull << 40;
+    std::memcpy(&corrupt[NETWORK_STRUCTURE_OFFSET], &hugeCount, sizeof(hugeCount));
+    writeRaw(corrupt);
+    CHECK(!loaded.loadFromFile(FILENAME));
+
+    CHECK(!loaded.loadFromFile("training_checkpoint_test_missing.dat"));
+
+    writeRaw(contents);
+    CHECK(loaded.loadFromFile(FILENAME));
+    CHECK(loaded.serialize() == contents);
+}
+
+// The RNG is per thread. Training mutates on the simulation thread, while the checkpoint is loaded
+// on the window thread, so the saved state only repeats the run when the mutating thread applies it.
+void testResumedRandomStateRepeatsNextMutation() {
+    const NeuralNetwork start({5, 6, 4});
+    std::vector<float> expected;
+    std::thread savingRun([&] {
+        TrainingCheckpoint checkpoint = makeCheckpoint();
+        checkpoint.rngState = getRandomState();
+        CHECK(checkpoint.saveToFile(FILENAME));
+        NeuralNetwork next = start;
+        NeuralNetwork::mutate(next, 0.2f);
+        expected = next.toGenome();
+    });
+    savingRun.join();
+
+    TrainingCheckpoint loaded;
+    CHECK(loaded.loadFromFile(FILENAME));
+    auto mutateOnNewThread = [&](bool applyState) {
+        std::vector<float> genome;
+        std::thread resumedRun([&] {
+            if (applyState) CHECK(setRandomState(loaded.rngState));
+            NeuralNetwork next = start;
+            NeuralNetwork::mutate(next, 0.2f);
+            genome = next.toGenome();
+        });
+        resumedRun.join();
+        return genome;
+    };
+    CHECK(mutateOnNewThread(true) == expected);
+
+    CHECK(setRandomState(loaded.rngState)); // On the loading thread only
+    CHECK(mutateOnNewThread(false) != expected);
+}
+}
+
+int main() {
+    testRoundTrip();
+    testCorruptInput();
+    testResumedRandomStateRepeatsNextMutation();
+    std::remove(FILENAME.c_str());
+    return testResult("TrainingCheckpointTest");
+}
@@ -0,0 +1,68 @@
+#include "TripleBuffer.hpp"
+#include "TestSupport.hpp"
+#include <thread>
+#include <cstdint>
+
+namespace {
+struct Payload {
+    uint64_t sequence = 0;
+    uint64_t check = 0; // Always ~sequence in a published value, so a torn read shows
+};
+
+void testSingleThread() {
+    TripleBuffer<int> buffer;
+    CHECK(!buffer.hasUnread());
+    CHECK(buffer.read() == 0);
+
+    buffer.writeSlot() = 1;
+    buffer.publish();
+    CHECK(buffer.hasUnread());
+    CHECK(buffer.read() == 1);
+    CHECK(!buffer.hasUnread());
+    CHECK(buffer.read() == 1); // Nothing new: the same value again
+
+    // A slow reader skips straight to the latest value
+    for (int value = 2; value <= 5; ++value) {
+        buffer.writeSlot() = value;
+        buffer.publish();
+    }
+    CHECK(buffer.read() == 5);
+    CHECK(!buffer.hasUnread());
+}
+
+void testConcurrentReaderSeesWholeValuesInOrder() {
+    TripleBuffer<Payload> buffer;
+    const uint64_t lastSequence = 200000;
+
+    std::thread writer([&buffer, lastSequence]() {
+        for (uint64_t sequence = 1; sequence <= lastSequence; ++sequence) {
+            Payload& slot = buffer.writeSlot();
+            slot.sequence = sequence;
+            slot.check = ~sequence;
+            buffer.publish();
+        }
+    });
+
+    uint64_t previous = 0;
+    bool consistent = true;
+    bool ordered = true;
+    while (previous < lastSequence) {
+        const Payload& value = buffer.read();
+        if (value.sequence == 0) continue; // Nothing published yet
+        consistent = consistent && value.check == ~value.sequence;
+        ordered = ordered && value.sequence >= previous;
+        previous = value.sequence;
+    }
+    writer.join();
+
+    CHECK(consistent);
+    CHECK(ordered);
+    CHECK(previous == lastSequence);
+}
+}
+
+int main() {
+    testSingleThread();
+    testConcurrentReaderSeesWholeValuesInOrder();
+    return testResult("TripleBufferTest");
+}